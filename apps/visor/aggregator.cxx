@@ -0,0 +1,162 @@
+#include "aggregator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <glm/common.hpp>
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+
+#include "../../libs/seqlock.hpp"
+#include "../../libs/file/file.h"
+
+namespace sc::visor::aggregator {
+
+    using sample_clock = std::chrono::high_resolution_clock;
+
+    static std::thread worker;
+    static std::atomic_bool working = false;
+    static options current_options;
+
+    static std::mutex sources_mutex;
+    static std::vector<std::weak_ptr<device_context>> sources;
+    static std::vector<mapping> current_mapping;
+
+    static seqlock<snapshot> published;
+
+    static std::optional<float> sample_at(const std::array<device_context::axis_sample, device_context::sample_history_length> &history, const size_t &count, const sample_clock::time_point &target, const bool &use_input) {
+        if (count == 0) return std::nullopt;
+        const auto value_of = [&](const device_context::axis_sample &sample) {
+            return use_input ? sample.input_fraction : sample.output_fraction;
+        };
+        if (target <= history[0].time) return value_of(history[0]);
+        for (size_t i = 1; i < count; i++) {
+            if (target > history[i].time) continue;
+            const auto span = std::chrono::duration<float>(history[i].time - history[i - 1].time).count();
+            if (span <= 0) return value_of(history[i]);
+            const auto into = std::chrono::duration<float>(target - history[i - 1].time).count();
+            return glm::mix(value_of(history[i - 1]), value_of(history[i]), into / span);
+        }
+        return value_of(history[count - 1]);
+    }
+
+    static void publish(const sample_clock::time_point &now) {
+        snapshot next;
+        next.sequence = published.sequence() + 1;
+        next.time = now;
+        const auto target = now - current_options.alignment_delay;
+        std::array<device_context::axis_sample, device_context::sample_history_length> history;
+        std::lock_guard guard(sources_mutex);
+        for (const auto &entry : current_mapping) {
+            if (entry.logical_axis_i < 0 || entry.logical_axis_i >= max_logical_axes) continue;
+            for (const auto &weak_source : sources) {
+                const auto source = weak_source.lock();
+                if (!source || source->serial != entry.serial) continue;
+                const auto count = source->copy_samples(entry.source_axis_i, history);
+                if (count == 0 || now - history[count - 1].time > current_options.stale_after) break;
+                if (const auto value = sample_at(history, count, target, entry.use_input); value) {
+                    next.present[entry.logical_axis_i] = true;
+                    next.axes[entry.logical_axis_i] = glm::clamp(*value, 0.f, 1.f);
+                }
+                break;
+            }
+        }
+        published.store(next);
+    }
+
+    static void work() {
+        const auto period = std::chrono::microseconds(1000000 / glm::max(1, current_options.rate_hz));
+        auto next_tick = sample_clock::now();
+        while (working) {
+            next_tick += period;
+            publish(sample_clock::now());
+            const auto now = sample_clock::now();
+            if (next_tick < now) next_tick = now;
+            else std::this_thread::sleep_until(next_tick);
+        }
+    }
+}
+
+void sc::visor::aggregator::startup(const options &opts) {
+    shutdown();
+    current_options = opts;
+    spdlog::debug("Starting up device aggregator at {}/second.", current_options.rate_hz);
+    working = true;
+    worker = std::thread(work);
+}
+
+void sc::visor::aggregator::shutdown() {
+    working = false;
+    if (worker.joinable()) {
+        worker.join();
+        spdlog::debug("Shutdown device aggregator.");
+    }
+}
+
+void sc::visor::aggregator::attach(const std::shared_ptr<device_context> &context) {
+    std::lock_guard guard(sources_mutex);
+    sources.erase(std::remove_if(sources.begin(), sources.end(), [](const std::weak_ptr<device_context> &source) {
+        return source.expired();
+    }), sources.end());
+    for (const auto &source : sources) if (source.lock() == context) return;
+    sources.push_back(context);
+}
+
+void sc::visor::aggregator::detach_all() {
+    std::lock_guard guard(sources_mutex);
+    sources.clear();
+}
+
+void sc::visor::aggregator::set_mapping(const std::vector<mapping> &new_mapping) {
+    std::lock_guard guard(sources_mutex);
+    current_mapping = new_mapping;
+}
+
+std::vector<sc::visor::aggregator::mapping> sc::visor::aggregator::get_mapping() {
+    std::lock_guard guard(sources_mutex);
+    return current_mapping;
+}
+
+sc::visor::aggregator::snapshot sc::visor::aggregator::latest() {
+    return published.load();
+}
+
+std::optional<std::string> sc::visor::aggregator::save_settings() {
+    nlohmann::json doc, mapping_doc = nlohmann::json::array();
+    for (const auto &entry : get_mapping()) {
+        mapping_doc.push_back({
+            { "serial", entry.serial },
+            { "axis", entry.source_axis_i },
+            { "logical_axis", entry.logical_axis_i },
+            { "input", entry.use_input }
+        });
+    }
+    doc["mapping"] = mapping_doc;
+    auto doc_content = doc.dump(4);
+    std::vector<std::byte> doc_data;
+    doc_data.resize(doc_content.size());
+    memcpy(doc_data.data(), doc_content.data(), glm::min(doc_data.size(), doc_content.size()));
+    if (const auto err = file::save("aggregate.json", doc_data); err) return *err;
+    return std::nullopt;
+}
+
+std::optional<std::string> sc::visor::aggregator::load_settings() {
+    const auto load_res = file::load("aggregate.json");
+    if (!load_res.has_value()) return load_res.error();
+    auto doc = nlohmann::json::parse(*load_res);
+    std::vector<mapping> loaded;
+    if (auto mapping_doc = doc.find("mapping"); mapping_doc != doc.end() && mapping_doc->is_array()) {
+        for (const auto &entry_doc : *mapping_doc) {
+            mapping entry;
+            entry.serial = entry_doc.value("serial", "");
+            entry.source_axis_i = entry_doc.value("axis", 0);
+            entry.logical_axis_i = entry_doc.value("logical_axis", 0);
+            entry.use_input = entry_doc.value("input", false);
+            loaded.push_back(entry);
+        }
+    }
+    set_mapping(loaded);
+    return std::nullopt;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "device_context.h"
+
+namespace sc::visor::aggregator {
+
+    static constexpr size_t max_logical_axes = 8;
+
+    struct mapping {
+
+        std::string serial;
+        int source_axis_i = 0;
+        int logical_axis_i = 0;
+        bool use_input = false;
+    };
+
+    struct snapshot {
+
+        uint64_t sequence = 0;
+        std::chrono::high_resolution_clock::time_point time;
+        std::array<bool, max_logical_axes> present = { false };
+        std::array<float, max_logical_axes> axes = { 0 };
+    };
+
+    struct options {
+
+        int rate_hz = 250;
+        std::chrono::microseconds alignment_delay = std::chrono::milliseconds(20);
+        std::chrono::microseconds stale_after = std::chrono::milliseconds(250);
+    };
+
+    void startup(const options &opts = { });
+    void shutdown();
+
+    void attach(const std::shared_ptr<device_context> &context);
+    void detach_all();
+
+    void set_mapping(const std::vector<mapping> &new_mapping);
+    std::vector<mapping> get_mapping();
+
+    snapshot latest();
+
+    std::optional<std::string> load_settings();
+    std::optional<std::string> save_settings();
+}
@@ -1,9 +1,16 @@
 #include "bezier.h"
 #include "im_glm_vec.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
 #include <glm/common.hpp>
+#include <glm/geometric.hpp>
 #include <fmt/format.h>
 
+#include "../../libs/pedals/spline.h"
+
 namespace sc::bezier::ui {
 
     static glm::dvec2 coords_to_screen(const glm::dvec2 &in, const glm::dvec2 &min, const glm::dvec2 &size) {
@@ -12,85 +19,149 @@ namespace sc::bezier::ui {
             (in.y * -size.y) + (min.y + size.y)
         };
     }
-}
 
-glm::dvec2 sc::bezier::calculate(std::vector<glm::dvec2> inputs, double power, std::optional<std::function<void(const std::vector<glm::dvec2> &level)>> callback) {
-    for (;;) {
-        for (int i = 0; i < inputs.size() - 1; i++) inputs[i] = glm::mix(inputs[i], inputs[i + 1], power);
-        inputs.resize(inputs.size() - 1);
-        if (inputs.size() == 1) return inputs.front();
-        if (callback) (*callback)(inputs);
-    }
-}
+    struct tessellation {
 
-void sc::bezier::ui::plot_cubic(std::vector<glm::dvec2> inputs, const glm::ivec2 &size, std::optional<double> fraction, std::optional<double> limit_min, std::optional<double> limit_max, std::optional<double> fraction_h) {
-    if (limit_min) for (auto &p : inputs) p.y += *limit_min * (1.0 - p.y);
-    auto draw_list = ImGui::GetWindowDrawList();
-    auto bez_area_min = ImGui::GetCursorScreenPos();
-    auto bez_area_size = size;
-    ImGui::Dummy(GLMD_IM2(size));
-    draw_list->AddRectFilled(
-        { static_cast<float>(bez_area_min.x), static_cast<float>(bez_area_min.y) },
-        { static_cast<float>(bez_area_min.x + bez_area_size.x), static_cast<float>(bez_area_min.y + bez_area_size.y) },
-        IM_COL32(255, 255, 255, 32),
-        ImGui::GetStyle().FrameRounding
-    );
-    ImGui::PushClipRect(bez_area_min, { bez_area_min.x + bez_area_size.x, bez_area_min.y + bez_area_size.y }, true);
-    bez_area_min.x += 12;
-    bez_area_min.y += 12;
-    bez_area_size.x -= 24;
-    bez_area_size.y -= 24;
-    auto screen_p = inputs;
-    for (auto &sp : screen_p) sp = coords_to_screen(sp, IM_GLMD2(bez_area_min), bez_area_size);
-    for (int i = 1; i < inputs.size(); i++) draw_list->AddLine(GLMD_IM2(screen_p[i - 1]), GLMD_IM2(screen_p[i]), IM_COL32(128, 255, 128, 32), 2.f);
-    const int num_curve_segments = 30;
-    auto last_plot = GLMD_IM2(coords_to_screen(inputs[0], IM_GLMD2(bez_area_min), bez_area_size));
-    for (int i = 1; i < num_curve_segments; i++) {
-        const double power = (1.0 / static_cast<double>(num_curve_segments)) * static_cast<double>(i);
-        const auto here = GLMD_IM2(coords_to_screen(calculate(inputs, power), IM_GLMD2(bez_area_min), bez_area_size));
-        draw_list->AddCircleFilled(last_plot, 1.f, IM_COL32(255, 165, 0, 255));
-        draw_list->AddLine(last_plot, here, IM_COL32(255, 165, 0, 255), 2.f);
-        last_plot = here;
-    }
-    draw_list->AddLine(last_plot, GLMD_IM2(coords_to_screen(inputs.back(), IM_GLMD2(bez_area_min), bez_area_size)), IM_COL32(255, 165, 0, 255), 2.f);
-    if (fraction.has_value()) {
-        const float height = bez_area_size.y * *fraction;
-        draw_list->AddLine({ bez_area_min.x, (bez_area_min.y + bez_area_size.y) - height }, { bez_area_min.x + bez_area_size.x, (bez_area_min.y + bez_area_size.y) - height }, IM_COL32(128, 255, 128, 64), 2.f);
-    }
-    if (fraction_h.has_value()) {
-        const float width = bez_area_size.x * *fraction_h;
-        draw_list->AddLine({ bez_area_min.x + width, bez_area_min.y }, { bez_area_min.x + width, bez_area_min.y + bez_area_size.y }, IM_COL32(128, 128, 255, 64), 2.f);
-    }
-    std::optional<int> hovering_point_i;
-    for (int i = 0; i < inputs.size(); i++) {
-        auto color = (i == 0 || i == inputs.size() - 1) ? IM_COL32(255, 165, 0, 255) : IM_COL32(255, 255, 255, 128);
-        ImGui::SetCursorScreenPos(GLMD_IM2(screen_p[i] - 3.0));
-        if (!hovering_point_i && ImGui::IsMouseHoveringRect(GLMD_IM2(screen_p[i] - 3.0), GLMD_IM2(screen_p[i] + 3.0))) {
-            ImGui::BeginTooltip();
-            ImGui::Text(fmt::format("#{}: x{}, y{}", i + 1, inputs[i].x, inputs[i].y).data());
-            ImGui::EndTooltip();
-            draw_list->AddRect(GLMD_IM2(screen_p[i] - 6.0), GLMD_IM2(screen_p[i] + 7.0), color, ImGui::GetStyle().FrameRounding, 0, 2);
-            hovering_point_i = i;
-        } else draw_list->AddRect(GLMD_IM2(screen_p[i] - 3.0), GLMD_IM2(screen_p[i] + 4.0), color, ImGui::GetStyle().FrameRounding, 0, 2);
+        std::vector<glm::dvec2> inputs;
+        bool spline = false;
+        glm::ivec2 size;
+        std::vector<glm::dvec2> polyline;
+        uint64_t last_used = 0;
+    };
+
+    static constexpr size_t max_tessellations = 16;
+    static constexpr int min_curve_segments = 16;
+    static constexpr int max_subdivisions = 4;
+    static constexpr double max_deviation_px = .25;
+
+    static std::vector<tessellation> tessellations;
+    static uint64_t num_lookups = 0;
+
+    static void subdivide(const std::function<glm::dvec2(double)> &curve, const glm::dvec2 &scale, const double &t0, const glm::dvec2 &p0, const double &t1, const glm::dvec2 &p1, const int &depth, std::vector<glm::dvec2> &polyline) {
+        const auto tm = (t0 + t1) * .5;
+        const auto pm = curve(tm);
+        if (depth < max_subdivisions && glm::length((pm - (p0 + p1) * .5) * scale) > max_deviation_px) {
+            subdivide(curve, scale, t0, p0, tm, pm, depth + 1, polyline);
+            subdivide(curve, scale, tm, pm, t1, p1, depth + 1, polyline);
+        } else polyline.push_back(p1);
     }
-    if (limit_max) {
-        const auto top_left = GLMD_IM2(coords_to_screen({ 0, *limit_max }, IM_GLMD2(bez_area_min), bez_area_size));
-        const auto top_right = GLMD_IM2(coords_to_screen({ 0.2, *limit_max }, IM_GLMD2(bez_area_min), bez_area_size));
-        draw_list->AddLine(top_left, top_right, IM_COL32(255, 255, 255, 200), 2.f);
-        draw_list->AddText({ top_left.x, top_left.y + 2 }, IM_COL32(255, 255, 255, 128), fmt::format("{}%", static_cast<int>(glm::round(*limit_max * 100.0))).data());
+
+    static const std::vector<glm::dvec2> &tessellate(const std::vector<glm::dvec2> &inputs, const bool &spline, const glm::ivec2 &size) {
+        num_lookups++;
+        for (auto &cached : tessellations) {
+            if (cached.spline != spline || cached.size != size || cached.inputs != inputs) continue;
+            cached.last_used = num_lookups;
+            return cached.polyline;
+        }
+        tessellations.reserve(max_tessellations);
+        if (tessellations.size() < max_tessellations) tessellations.emplace_back();
+        const auto slot = std::min_element(tessellations.begin(), tessellations.end(), [](const tessellation &a, const tessellation &b) {
+            return a.last_used < b.last_used;
+        });
+        slot->inputs = inputs;
+        slot->spline = spline;
+        slot->size = size;
+        slot->last_used = num_lookups;
+        slot->polyline.clear();
+        slot->polyline.push_back(inputs.front());
+        const glm::dvec2 scale = { size.x - 24, size.y - 24 };
+        std::function<glm::dvec2(double)> curve = [&inputs](double power) {
+            return calculate(inputs, power);
+        };
+        if (spline) {
+            curve = [fitted = pedals::monotone_spline::fit(inputs), x_min = inputs.front().x, x_max = inputs.back().x](double power) {
+                const auto x = glm::mix(x_min, x_max, power);
+                return glm::dvec2 { x, fitted.evaluate(x) };
+            };
+        }
+        auto last = inputs.front();
+        for (int i = 1; i <= min_curve_segments; i++) {
+            const auto t0 = static_cast<double>(i - 1) / static_cast<double>(min_curve_segments);
+            const auto t1 = static_cast<double>(i) / static_cast<double>(min_curve_segments);
+            const auto here = i == min_curve_segments ? inputs.back() : curve(t1);
+            subdivide(curve, scale, t0, last, t1, here, 0, slot->polyline);
+            last = here;
+        }
+        return slot->polyline;
     }
-    if (limit_min) {
-        const auto bottom_right = GLMD_IM2(coords_to_screen({ 1, *limit_min }, IM_GLMD2(bez_area_min), bez_area_size));
-        const auto bottom_left = GLMD_IM2(coords_to_screen({ 0, *limit_min }, IM_GLMD2(bez_area_min), bez_area_size));
-        draw_list->AddLine(bottom_left, bottom_right, IM_COL32(255, 255, 255, 200), 2.f);
-        const auto text = fmt::format("{}%", static_cast<int>(glm::round(*limit_min * 100.0)));
-        const auto text_dim = ImGui::CalcTextSize(text.data());
-        draw_list->AddText({ bottom_right.x - text_dim.x, bottom_right.y - text_dim.y - 2 }, IM_COL32(255, 255, 255, 128), text.data());
+
+    static void plot(std::vector<glm::dvec2> inputs, const bool &spline, const glm::ivec2 &size, std::optional<double> fraction, std::optional<double> limit_min, std::optional<double> limit_max, std::optional<double> fraction_h) {
+        if (limit_min) for (auto &p : inputs) p.y += *limit_min * (1.0 - p.y);
+        auto draw_list = ImGui::GetWindowDrawList();
+        auto bez_area_min = ImGui::GetCursorScreenPos();
+        auto bez_area_size = size;
+        ImGui::Dummy(GLMD_IM2(size));
+        draw_list->AddRectFilled(
+            { static_cast<float>(bez_area_min.x), static_cast<float>(bez_area_min.y) },
+            { static_cast<float>(bez_area_min.x + bez_area_size.x), static_cast<float>(bez_area_min.y + bez_area_size.y) },
+            IM_COL32(255, 255, 255, 32),
+            ImGui::GetStyle().FrameRounding
+        );
+        ImGui::PushClipRect(bez_area_min, { bez_area_min.x + bez_area_size.x, bez_area_min.y + bez_area_size.y }, true);
+        bez_area_min.x += 12;
+        bez_area_min.y += 12;
+        bez_area_size.x -= 24;
+        bez_area_size.y -= 24;
+        auto screen_p = inputs;
+        for (auto &sp : screen_p) sp = coords_to_screen(sp, IM_GLMD2(bez_area_min), bez_area_size);
+        if (!spline) {
+            for (int i = 1; i < inputs.size(); i++) draw_list->AddLine(GLMD_IM2(screen_p[i - 1]), GLMD_IM2(screen_p[i]), IM_COL32(128, 255, 128, 32), 2.f);
+        }
+        const auto &polyline = tessellate(inputs, spline, size);
+        auto last_plot = GLMD_IM2(coords_to_screen(polyline.front(), IM_GLMD2(bez_area_min), bez_area_size));
+        for (int i = 1; i < polyline.size(); i++) {
+            const auto here = GLMD_IM2(coords_to_screen(polyline[i], IM_GLMD2(bez_area_min), bez_area_size));
+            if (i < polyline.size() - 1) draw_list->AddCircleFilled(last_plot, 1.f, IM_COL32(255, 165, 0, 255));
+            draw_list->AddLine(last_plot, here, IM_COL32(255, 165, 0, 255), 2.f);
+            last_plot = here;
+        }
+        if (fraction.has_value()) {
+            const float height = bez_area_size.y * *fraction;
+            draw_list->AddLine({ bez_area_min.x, (bez_area_min.y + bez_area_size.y) - height }, { bez_area_min.x + bez_area_size.x, (bez_area_min.y + bez_area_size.y) - height }, IM_COL32(128, 255, 128, 64), 2.f);
+        }
+        if (fraction_h.has_value()) {
+            const float width = bez_area_size.x * *fraction_h;
+            draw_list->AddLine({ bez_area_min.x + width, bez_area_min.y }, { bez_area_min.x + width, bez_area_min.y + bez_area_size.y }, IM_COL32(128, 128, 255, 64), 2.f);
+        }
+        std::optional<int> hovering_point_i;
+        for (int i = 0; i < inputs.size(); i++) {
+            auto color = (i == 0 || i == inputs.size() - 1) ? IM_COL32(255, 165, 0, 255) : IM_COL32(255, 255, 255, 128);
+            ImGui::SetCursorScreenPos(GLMD_IM2(screen_p[i] - 3.0));
+            if (!hovering_point_i && ImGui::IsMouseHoveringRect(GLMD_IM2(screen_p[i] - 3.0), GLMD_IM2(screen_p[i] + 3.0))) {
+                ImGui::BeginTooltip();
+                ImGui::Text(fmt::format("#{}: x{}, y{}", i + 1, inputs[i].x, inputs[i].y).data());
+                ImGui::EndTooltip();
+                draw_list->AddRect(GLMD_IM2(screen_p[i] - 6.0), GLMD_IM2(screen_p[i] + 7.0), color, ImGui::GetStyle().FrameRounding, 0, 2);
+                hovering_point_i = i;
+            } else draw_list->AddRect(GLMD_IM2(screen_p[i] - 3.0), GLMD_IM2(screen_p[i] + 4.0), color, ImGui::GetStyle().FrameRounding, 0, 2);
+        }
+        if (limit_max) {
+            const auto top_left = GLMD_IM2(coords_to_screen({ 0, *limit_max }, IM_GLMD2(bez_area_min), bez_area_size));
+            const auto top_right = GLMD_IM2(coords_to_screen({ 0.2, *limit_max }, IM_GLMD2(bez_area_min), bez_area_size));
+            draw_list->AddLine(top_left, top_right, IM_COL32(255, 255, 255, 200), 2.f);
+            draw_list->AddText({ top_left.x, top_left.y + 2 }, IM_COL32(255, 255, 255, 128), fmt::format("{}%", static_cast<int>(glm::round(*limit_max * 100.0))).data());
+        }
+        if (limit_min) {
+            const auto bottom_right = GLMD_IM2(coords_to_screen({ 1, *limit_min }, IM_GLMD2(bez_area_min), bez_area_size));
+            const auto bottom_left = GLMD_IM2(coords_to_screen({ 0, *limit_min }, IM_GLMD2(bez_area_min), bez_area_size));
+            draw_list->AddLine(bottom_left, bottom_right, IM_COL32(255, 255, 255, 200), 2.f);
+            const auto text = fmt::format("{}%", static_cast<int>(glm::round(*limit_min * 100.0)));
+            const auto text_dim = ImGui::CalcTextSize(text.data());
+            draw_list->AddText({ bottom_right.x - text_dim.x, bottom_right.y - text_dim.y - 2 }, IM_COL32(255, 255, 255, 128), text.data());
+        }
+        bez_area_min.x -= 12;
+        bez_area_min.y -= 12;
+        bez_area_size.x += 24;
+        bez_area_size.y += 24;
+        ImGui::PopClipRect();
+        ImGui::SetCursorScreenPos({ bez_area_min.x, bez_area_min.y + bez_area_size.y + ImGui::GetStyle().FramePadding.y });
     }
-    bez_area_min.x -= 12;
-    bez_area_min.y -= 12;
-    bez_area_size.x += 24;
-    bez_area_size.y += 24;
-    ImGui::PopClipRect();
-    ImGui::SetCursorScreenPos({ bez_area_min.x, bez_area_min.y + bez_area_size.y + ImGui::GetStyle().FramePadding.y });
+}
+
+void sc::bezier::ui::plot_cubic(std::vector<glm::dvec2> inputs, const glm::ivec2 &size, std::optional<double> fraction, std::optional<double> limit_min, std::optional<double> limit_max, std::optional<double> fraction_h) {
+    plot(std::move(inputs), false, size, fraction, limit_min, limit_max, fraction_h);
+}
+
+void sc::bezier::ui::plot_spline(std::vector<glm::dvec2> inputs, const glm::ivec2 &size, std::optional<double> fraction, std::optional<double> limit_min, std::optional<double> limit_max, std::optional<double> fraction_h) {
+    plot(std::move(inputs), true, size, fraction, limit_min, limit_max, fraction_h);
 }
\ No newline at end of file
@@ -1,17 +1,17 @@
 #pragma once
 
 #include <optional>
-#include <functional>
 #include <vector>
 
 #include <glm/vec2.hpp>
 
-namespace sc::bezier {
+#include "../../libs/bezier/bezier.h"
 
-    glm::dvec2 calculate(std::vector<glm::dvec2> inputs, double power, std::optional<std::function<void(const std::vector<glm::dvec2> &level)>> callback = std::nullopt);
+namespace sc::bezier {
 
     namespace ui {
 
         void plot_cubic(std::vector<glm::dvec2> inputs, const glm::ivec2 &size, std::optional<double> fraction = std::nullopt, std::optional<double> limit_min = std::nullopt, std::optional<double> limit_max = std::nullopt, std::optional<double> fraction_h = std::nullopt);
+        void plot_spline(std::vector<glm::dvec2> inputs, const glm::ivec2 &size, std::optional<double> fraction = std::nullopt, std::optional<double> limit_min = std::nullopt, std::optional<double> limit_max = std::nullopt, std::optional<double> fraction_h = std::nullopt);
     }
 }
\ No newline at end of file
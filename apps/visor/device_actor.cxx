@@ -0,0 +1,268 @@
+#include "device_actor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <glm/common.hpp>
+#include <spdlog/spdlog.h>
+
+#include "../../libs/defer.hpp"
+
+sc::visor::device_actor::device_actor(const std::shared_ptr<firmware::mk4::device_handle> &handle, const std::shared_ptr<device_context> &context, device_event_queue &events) : handle(handle), context(context), events(events) {
+
+}
+
+sc::visor::device_actor::~device_actor() {
+    stop();
+}
+
+void sc::visor::device_actor::start() {
+    stop();
+    working = true;
+    alive = true;
+    worker = std::thread([this]() {
+        work();
+    });
+}
+
+void sc::visor::device_actor::stop() {
+    working = false;
+    if (worker.joinable()) worker.join();
+}
+
+bool sc::visor::device_actor::running() const {
+    return alive;
+}
+
+void sc::visor::device_actor::emit(const device_event::kind &type, const std::optional<std::string> &error) {
+    if (!context->attached_pending && events.try_push(device_event { type, context, error })) return;
+    if (type == device_event::kind::lost) {
+        context->lost_pending = true;
+        spdlog::warn("Device event queue is full, deferring lost event for {}.", context->serial);
+    } else spdlog::warn("Device event queue is full, dropping event for {}.", context->serial);
+}
+
+void sc::visor::device_actor::work() {
+    DEFER({
+        context->connected = false;
+        context->initial_communication_complete = false;
+        alive = false;
+    });
+    context->connected = true;
+    context->initial_communication_complete = false;
+    for (int num_stale = 0; context->commands.try_pop(); num_stale++) spdlog::debug("Discarded stale command #{} for {}.", num_stale + 1, context->serial);
+    if (const auto err = handshake(); err) {
+        emit(device_event::kind::lost, err);
+        return;
+    }
+    context->initial_communication_complete = true;
+    emit(device_event::kind::ready);
+    auto next_poll = std::chrono::high_resolution_clock::now();
+    while (working) {
+        while (const auto command = context->commands.try_pop()) {
+            if (const auto err = apply(*command); err) {
+                spdlog::error(*err);
+                emit(device_event::kind::command_failed, err);
+            }
+        }
+        if (const auto err = poll(); err) {
+            emit(device_event::kind::lost, err);
+            return;
+        }
+        next_poll += std::chrono::milliseconds(10);
+        const auto now = std::chrono::high_resolution_clock::now();
+        if (next_poll < now) next_poll = now;
+        else std::this_thread::sleep_until(next_poll);
+    }
+}
+
+std::optional<std::string> sc::visor::device_actor::handshake() {
+    const auto version_res = handle->get_version();
+    if (!version_res.has_value()) return version_res.error();
+    const auto axes_res = handle->get_num_axes();
+    if (!axes_res.has_value()) return axes_res.error();
+    std::vector<firmware::mk4::device_handle::axis_info> axes(*axes_res);
+    for (int axis_i = 0; axis_i < axes.size(); axis_i++) {
+        const auto res = handle->get_axis_state(axis_i);
+        if (!res.has_value()) return res.error();
+        axes[axis_i] = *res;
+    }
+    std::array<std::array<char, 50>, std::tuple_size<decltype(context->models)>::value> labels;
+    std::array<std::array<glm::vec2, 6>, std::tuple_size<decltype(context->models)>::value> models;
+    for (int model_i = 0; model_i < models.size(); model_i++) {
+        const auto label_res = handle->get_bezier_label(model_i);
+        if (!label_res.has_value()) return label_res.error();
+        labels[model_i] = *label_res;
+        const auto model_res = handle->get_bezier_model(model_i);
+        if (!model_res.has_value()) return model_res.error();
+        models[model_i] = *model_res;
+    }
+    SC_LOCK_GUARD(context->mutex);
+    context->version_major = std::get<0>(*version_res);
+    context->version_minor = std::get<1>(*version_res);
+    context->version_revision = std::get<2>(*version_res);
+    context->axes = axes;
+    context->axes_ex.resize(axes.size());
+    for (int axis_i = 0; axis_i < axes.size(); axis_i++) {
+        context->axes_ex[axis_i].range_min = axes[axis_i].min;
+        context->axes_ex[axis_i].range_max = axes[axis_i].max;
+        context->axes_ex[axis_i].deadzone = axes[axis_i].deadzone;
+        context->axes_ex[axis_i].limit = axes[axis_i].limit;
+        context->axes_ex[axis_i].model_edit_i = axes[axis_i].curve_i;
+        context->axes_ex[axis_i].requested_curve_i = axes[axis_i].curve_i;
+        context->record_sample(axis_i, axes[axis_i]);
+    }
+    for (int model_i = 0; model_i < models.size(); model_i++) {
+        if (strnlen(labels[model_i].data(), labels[model_i].size()) > 0) {
+            context->models[model_i].label = std::string(labels[model_i].data(), strnlen(labels[model_i].data(), labels[model_i].size()));
+            memcpy(context->models[model_i].label_buffer.data(), labels[model_i].data(), labels[model_i].size());
+        }
+        for (int element_i = 0; element_i < context->models[model_i].points.size(); element_i++) {
+            context->models[model_i].points[element_i].x = glm::round((models[model_i][element_i].x * static_cast<float>(std::numeric_limits<uint16_t>::max())) / 655.35f);
+            context->models[model_i].points[element_i].y = glm::round((models[model_i][element_i].y * static_cast<float>(std::numeric_limits<uint16_t>::max())) / 655.35f);
+            spdlog::debug("Curve Info: model #{}, point #{}: {}, {}", model_i, element_i, context->models[model_i].points[element_i].x, context->models[model_i].points[element_i].y);
+        }
+    }
+    context->last_communication = std::chrono::high_resolution_clock::now();
+    return std::nullopt;
+}
+
+std::optional<std::string> sc::visor::device_actor::poll() {
+    std::array<firmware::mk4::device_handle::axis_info, device_context::max_sampled_axes> axes;
+    const auto num_axes = glm::min(context->axes_ex.size(), axes.size());
+    for (int axis_i = 0; axis_i < num_axes; axis_i++) {
+        const auto res = handle->get_axis_state(axis_i);
+        if (!res.has_value()) return res.error();
+        axes[axis_i] = *res;
+        context->record_sample(axis_i, axes[axis_i]);
+    }
+    SC_LOCK_GUARD(context->mutex);
+    for (int axis_i = 0; axis_i < num_axes && axis_i < context->axes.size(); axis_i++) context->axes[axis_i] = axes[axis_i];
+    context->last_communication = std::chrono::high_resolution_clock::now();
+    return std::nullopt;
+}
+
+std::optional<std::string> sc::visor::device_actor::apply(const device_command &command) {
+    switch (command.type) {
+        case device_command::kind::set_axis_enabled:
+            return handle->set_axis_enabled(command.index, command.enabled);
+        case device_command::kind::set_axis_range:
+            if (const auto err = handle->set_axis_range(command.index, command.range_min, command.range_max, command.deadzone, command.limit); err) return err;
+            spdlog::info("Updated axis #{} range: {}, {}, {}", command.index, command.range_min, command.range_max, command.limit);
+            return std::nullopt;
+        case device_command::kind::set_axis_curve:
+            if (const auto err = handle->set_axis_bezier_index(command.index, command.curve_i); err) {
+                SC_LOCK_GUARD(context->mutex);
+                if (command.index >= 0 && command.index < context->axes_ex.size() && context->axes_ex[command.index].requested_curve_i == command.curve_i) context->axes_ex[command.index].requested_curve_i = -1;
+                return err;
+            }
+            spdlog::info("Axis model index updated.");
+            return std::nullopt;
+        case device_command::kind::set_model:
+            if (const auto err = handle->set_bezier_model(command.index, command.model); err) return err;
+            spdlog::info("Model updated.");
+            return std::nullopt;
+        case device_command::kind::set_label:
+            return handle->set_bezier_label(command.index, std::string_view(command.label.data(), strnlen(command.label.data(), command.label.size())));
+        case device_command::kind::commit:
+            if (const auto err = handle->commit(); err) return err;
+            spdlog::info("Settings saved.");
+            return std::nullopt;
+    }
+    return std::nullopt;
+}
+
+namespace sc::visor::device_supervisor {
+
+    static std::thread worker;
+    static std::atomic_bool working = false;
+    static device_event_queue events;
+    static std::vector<std::unique_ptr<device_actor>> actors;
+    static std::vector<std::shared_ptr<device_context>> contexts;
+
+    static void reap() {
+        for (int i = 0; i < actors.size(); i++) {
+            if (actors[i]->running()) continue;
+            spdlog::debug("Releasing device handle: {}", actors[i]->handle->serial);
+            actors.erase(actors.begin() + i);
+            i--;
+        }
+    }
+
+    static void discover() {
+        std::vector<std::shared_ptr<firmware::mk4::device_handle>> open_handles;
+        for (const auto &actor : actors) open_handles.push_back(actor->handle);
+        auto res = firmware::mk4::discover(open_handles);
+        if (!res.has_value()) {
+            spdlog::error(res.error());
+            return;
+        }
+        if (res->size()) spdlog::debug("Found {} devices.", res->size());
+        for (auto &handle : *res) {
+            auto context_i = std::find_if(contexts.begin(), contexts.end(), [&handle](const std::shared_ptr<device_context> &context) {
+                return context->serial == handle->serial;
+            });
+            if (context_i == contexts.end()) {
+                spdlog::debug("Created new device context: {}", handle->serial);
+                auto new_context = std::make_shared<device_context>();
+                new_context->name = handle->name;
+                new_context->serial = handle->serial;
+                contexts.push_back(new_context);
+                context_i = contexts.end() - 1;
+                announce(events, new_context);
+            } else spdlog::debug("Applied new handle to device context: {}", handle->serial);
+            actors.push_back(std::make_unique<device_actor>(handle, *context_i, events));
+            actors.back()->start();
+        }
+    }
+
+    static void work() {
+        auto last_scan = std::chrono::high_resolution_clock::now();
+        while (working) {
+            reap();
+            flush_deferred(events, contexts);
+            if (std::chrono::high_resolution_clock::now() - last_scan >= std::chrono::seconds(1)) {
+                discover();
+                last_scan = std::chrono::high_resolution_clock::now();
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        actors.clear();
+    }
+}
+
+void sc::visor::announce(device_event_queue &events, const std::shared_ptr<device_context> &context) {
+    context->attached_pending = true;
+    if (events.try_push(device_event { device_event::kind::attached, context })) context->attached_pending = false;
+    else spdlog::warn("Device event queue is full, deferring attached event for {}.", context->serial);
+}
+
+void sc::visor::flush_deferred(device_event_queue &events, const std::vector<std::shared_ptr<device_context>> &contexts) {
+    for (const auto &context : contexts) {
+        if (context->attached_pending) {
+            if (!events.try_push(device_event { device_event::kind::attached, context })) continue;
+            context->attached_pending = false;
+        }
+        if (context->lost_pending && events.try_push(device_event { device_event::kind::lost, context })) context->lost_pending = false;
+    }
+}
+
+void sc::visor::device_supervisor::startup() {
+    shutdown();
+    spdlog::debug("Starting up device supervisor.");
+    working = true;
+    worker = std::thread(work);
+}
+
+void sc::visor::device_supervisor::shutdown() {
+    working = false;
+    if (worker.joinable()) {
+        worker.join();
+        spdlog::debug("Shutdown device supervisor.");
+    }
+}
+
+std::optional<sc::visor::device_event> sc::visor::device_supervisor::next_event() {
+    return events.try_pop();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "device_context.h"
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../libs/mpsc_queue.hpp"
+
+namespace sc::visor {
+
+    struct device_event {
+
+        enum class kind {
+
+            attached,
+            ready,
+            command_failed,
+            lost
+        };
+
+        kind type;
+        std::shared_ptr<device_context> context;
+        std::optional<std::string> error;
+    };
+
+    using device_event_queue = mpsc_queue<device_event, 256>;
+
+    struct device_actor {
+
+        const std::shared_ptr<firmware::mk4::device_handle> handle;
+        const std::shared_ptr<device_context> context;
+
+        device_actor(const std::shared_ptr<firmware::mk4::device_handle> &handle, const std::shared_ptr<device_context> &context, device_event_queue &events);
+        device_actor(const device_actor &) = delete;
+        device_actor &operator=(const device_actor &) = delete;
+        ~device_actor();
+
+        void start();
+        void stop();
+        bool running() const;
+
+    private:
+
+        device_event_queue &events;
+        std::thread worker;
+        std::atomic_bool working = false;
+        std::atomic_bool alive = false;
+
+        void work();
+        void emit(const device_event::kind &type, const std::optional<std::string> &error = std::nullopt);
+        std::optional<std::string> handshake();
+        std::optional<std::string> poll();
+        std::optional<std::string> apply(const device_command &command);
+    };
+
+    void announce(device_event_queue &events, const std::shared_ptr<device_context> &context);
+    void flush_deferred(device_event_queue &events, const std::vector<std::shared_ptr<device_context>> &contexts);
+
+    namespace device_supervisor {
+
+        void startup();
+        void shutdown();
+        std::optional<device_event> next_event();
+    }
+}
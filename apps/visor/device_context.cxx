@@ -1,58 +1,73 @@
 #include "device_context.h"
 
-#include "../../libs/defer.hpp"
+#include <cstring>
 
 #include <glm/common.hpp>
 #include <spdlog/spdlog.h>
-#include <spdlog/fmt/bin_to_hex.h>
-
-std::optional<std::string> sc::visor::device_context::update(std::shared_ptr<device_context> context) {
-    if (!context || !context->handle) return std::nullopt;
-    std::lock_guard guard(context->mutex);
-    {
-        const auto now = std::chrono::high_resolution_clock::now();
-        if (!context->last_communication) context->last_communication = now;
-        if (std::chrono::duration_cast<std::chrono::milliseconds>(now - *context->last_communication).count() < 10) return std::nullopt;
-    }
-    DEFER(context->last_communication = std::chrono::high_resolution_clock::now(););
-    if (const auto res = context->handle->get_version(); res.has_value()) {
-        context->version_major = std::get<0>(*res);
-        context->version_minor = std::get<1>(*res);
-        context->version_revision = std::get<2>(*res);
-    } else return res.error();
-    const auto axes_res = context->handle->get_num_axes();
-    if (!axes_res.has_value()) return axes_res.error();
-    context->axes.resize(*axes_res);
-    context->axes_ex.resize(context->axes.size());
-    for (int axis_i = 0; axis_i < *axes_res; axis_i++) {
-        const auto res = context->handle->get_axis_state(axis_i);
-        if (!res.has_value()) return res.error();
-        if (!context->initial_communication_complete) {
-            context->axes_ex[axis_i].range_min = res->min;
-            context->axes_ex[axis_i].range_max = res->max;
-            context->axes_ex[axis_i].deadzone = res->deadzone;
-            context->axes_ex[axis_i].limit = res->limit;
-            context->axes_ex[axis_i].model_edit_i = res->curve_i;
-        }
-        context->axes[axis_i] = *res;
-    }
-    if (!context->initial_communication_complete) {
-        for (int model_i = 0; model_i < context->models.size(); model_i++) {
-            const auto label_res = context->handle->get_bezier_label(model_i);
-            if (!label_res.has_value()) return label_res.error();
-            if (strnlen_s(label_res->data(), 50) > 0) {
-                context->models[model_i].label = label_res->data();
-                memcpy(context->models[model_i].label_buffer.data(), label_res->data(), label_res->size());
-            }
-            const auto model_res = context->handle->get_bezier_model(model_i);
-            if (!model_res.has_value()) return model_res.error();
-            for (int element_i = 0; element_i < context->models[model_i].points.size(); element_i++) {
-                context->models[model_i].points[element_i].x = glm::round((model_res.value()[element_i].x * static_cast<float>(std::numeric_limits<uint16_t>::max())) / 655.35f);
-                context->models[model_i].points[element_i].y = glm::round((model_res.value()[element_i].y * static_cast<float>(std::numeric_limits<uint16_t>::max())) / 655.35f);
-                spdlog::debug("Curve Info: model #{}, point #{}: {}, {}", model_i, element_i, context->models[model_i].points[element_i].x, context->models[model_i].points[element_i].y);
-            }
-        }
-    }
-    context->initial_communication_complete = true;
-    return std::nullopt;
+
+sc::visor::device_command sc::visor::device_command::axis_enabled(const int &axis_i, const bool &enabled) {
+    device_command command { kind::set_axis_enabled };
+    command.index = axis_i;
+    command.enabled = enabled;
+    return command;
+}
+
+sc::visor::device_command sc::visor::device_command::axis_range(const int &axis_i, const uint16_t &min, const uint16_t &max, const uint8_t &deadzone, const uint8_t &limit) {
+    device_command command { kind::set_axis_range };
+    command.index = axis_i;
+    command.range_min = min;
+    command.range_max = max;
+    command.deadzone = deadzone;
+    command.limit = limit;
+    return command;
+}
+
+sc::visor::device_command sc::visor::device_command::axis_curve(const int &axis_i, const int8_t &curve_i) {
+    device_command command { kind::set_axis_curve };
+    command.index = axis_i;
+    command.curve_i = curve_i;
+    return command;
+}
+
+sc::visor::device_command sc::visor::device_command::bezier_model(const int &model_i, const std::array<glm::vec2, 6> &model) {
+    device_command command { kind::set_model };
+    command.index = model_i;
+    command.model = model;
+    return command;
+}
+
+sc::visor::device_command sc::visor::device_command::bezier_label(const int &model_i, const std::string_view &label) {
+    device_command command { kind::set_label };
+    command.index = model_i;
+    memcpy(command.label.data(), label.data(), glm::min(label.size(), command.label.size() - 1));
+    return command;
+}
+
+sc::visor::device_command sc::visor::device_command::save() {
+    return device_command { kind::commit };
+}
+
+bool sc::visor::device_context::post(const device_command &command) {
+    if (!connected) return false;
+    if (commands.try_push(command)) return true;
+    spdlog::warn("Command queue for {} is full, dropping command.", serial);
+    return false;
+}
+
+void sc::visor::device_context::record_sample(const int &axis_i, const firmware::mk4::device_handle::axis_info &info) {
+    if (axis_i < 0 || axis_i >= max_sampled_axes) return;
+    std::lock_guard guard(samples_mutex);
+    auto &sample = samples[axis_i][num_samples[axis_i] % sample_history_length];
+    sample.time = std::chrono::high_resolution_clock::now();
+    sample.input_fraction = info.input_fraction;
+    sample.output_fraction = info.output_fraction;
+    num_samples[axis_i]++;
+}
+
+size_t sc::visor::device_context::copy_samples(const int &axis_i, std::array<axis_sample, sample_history_length> &out) {
+    if (axis_i < 0 || axis_i >= max_sampled_axes) return 0;
+    std::lock_guard guard(samples_mutex);
+    const auto count = glm::min(num_samples[axis_i], static_cast<uint64_t>(sample_history_length));
+    for (size_t i = 0; i < count; i++) out[i] = samples[axis_i][(num_samples[axis_i] - count + i) % sample_history_length];
+    return count;
 }
\ No newline at end of file
@@ -1,26 +1,69 @@
 #pragma once
 
 #include "../../libs/firmware/mk4.h"
+#include "../../libs/diagnostics/diagnostics.h"
+#include "../../libs/mpsc_queue.hpp"
 
 #include <array>
 #include <limits>
 #include <mutex>
 #include <optional>
-#include <future>
+#include <string_view>
 #include <vector>
 #include <atomic>
+#include <chrono>
+#include <string>
 
 #include <glm/vec2.hpp>
 
 namespace sc::visor {
 
+    struct device_command {
+
+        enum class kind {
+
+            set_axis_enabled,
+            set_axis_range,
+            set_axis_curve,
+            set_model,
+            set_label,
+            commit
+        };
+
+        kind type;
+        int index = 0;
+        bool enabled = false;
+        uint16_t range_min = 0, range_max = std::numeric_limits<uint16_t>::max();
+        uint8_t deadzone = 0, limit = 100;
+        int8_t curve_i = -1;
+        std::array<glm::vec2, 6> model;
+        std::array<char, 50> label = { 0 };
+
+        static device_command axis_enabled(const int &axis_i, const bool &enabled);
+        static device_command axis_range(const int &axis_i, const uint16_t &min, const uint16_t &max, const uint8_t &deadzone, const uint8_t &limit);
+        static device_command axis_curve(const int &axis_i, const int8_t &curve_i);
+        static device_command bezier_model(const int &model_i, const std::array<glm::vec2, 6> &model);
+        static device_command bezier_label(const int &model_i, const std::string_view &label);
+        static device_command save();
+    };
+
     struct device_context {
 
+        static constexpr size_t max_sampled_axes = 8;
+        static constexpr size_t sample_history_length = 4;
+
+        struct axis_sample {
+
+            std::chrono::high_resolution_clock::time_point time;
+            float input_fraction = 0, output_fraction = 0;
+        };
+
         struct axis_info_ex {
 
             int range_min = 0, range_max = std::numeric_limits<uint16_t>::max();
             int deadzone = 0, limit = 100;
             int model_edit_i = -1;
+            int requested_curve_i = -1;
         };
 
         struct model {
@@ -40,16 +83,24 @@ namespace sc::visor {
 
         std::array<model, 5> models;
 
-        std::mutex mutex;
+        diagnostics::instrumented_mutex mutex { "device_context::mutex" };
         std::optional<std::chrono::high_resolution_clock::time_point> last_communication;
-        std::shared_ptr<firmware::mk4::device_handle> handle;
         std::atomic_int version_major, version_minor, version_revision;
         std::string name, serial;
         std::vector<firmware::mk4::device_handle::axis_info> axes;
         std::vector<axis_info_ex> axes_ex;
-        std::future<std::optional<std::string>> update_future;
+        std::atomic_bool connected = false;
         std::atomic_bool initial_communication_complete = false;
+        std::atomic_bool attached_pending = false;
+        std::atomic_bool lost_pending = false;
+        mpsc_queue<device_command, 64> commands;
+
+        std::mutex samples_mutex;
+        std::array<std::array<axis_sample, sample_history_length>, max_sampled_axes> samples;
+        std::array<uint64_t, max_sampled_axes> num_samples = { 0 };
 
-        static std::optional<std::string> update(std::shared_ptr<device_context> context);
+        void record_sample(const int &axis_i, const firmware::mk4::device_handle::axis_info &info);
+        size_t copy_samples(const int &axis_i, std::array<axis_sample, sample_history_length> &out);
+        bool post(const device_command &command);
     };
 }
\ No newline at end of file
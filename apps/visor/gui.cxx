@@ -2,7 +2,9 @@
 #include "application.h"
 #include "animation_instance.h"
 #include "device_context.h"
+#include "aggregator.h"
 #include "legacy.h"
+#include "service.h"
 
 #include <string_view>
 #include <array>
@@ -30,6 +32,8 @@
 #include "../../libs/resource/resource.h"
 #include "../../libs/iracing/iracing.h"
 #include "../../libs/api/api.h"
+#include "../../libs/diagnostics/diagnostics.h"
+#include "../../libs/pedals/spline.h"
 
 #include "bezier.h"
 #include "im_glm_vec.hpp"
@@ -103,13 +107,6 @@ namespace sc::visor::gui {
     static nlohmann::json cfg;
 
     static animation_instance animation_scan, animation_comm, animation_under_construction;
-    static std::optional<std::chrono::high_resolution_clock::time_point> devices_last_scan;
-    static std::future<tl::expected<std::vector<std::shared_ptr<sc::firmware::mk4::device_handle>>, std::string>> devices_future;
-    static std::vector<std::shared_ptr<firmware::mk4::device_handle>> devices;
-    static std::vector<std::shared_ptr<device_context>> device_contexts;
-
-    static bool legacy_is_default = true;
-    static bool enable_legacy_support = false;
 
     static bool should_verify_session_token = false;
     static std::optional<std::string> account_session_token;
@@ -204,66 +201,6 @@ namespace sc::visor::gui {
         prepare_animation("LOTTIE_UNDER_CONSTRUCTION", animation_under_construction, { 400, 400 });
     }
 
-    static void poll_devices() {
-        if (devices_future.valid()) {
-            if (devices_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-                auto res = devices_future.get();
-                DEFER(devices_future = { });
-                if (!res.has_value()) {
-                    spdlog::error(res.error());
-                    return;
-                }
-                for (auto &new_device : *res) devices.push_back(new_device);
-                devices_last_scan = std::chrono::high_resolution_clock::now();
-                if (res->size()) spdlog::debug("Found {} devices.", res->size());
-            }
-        } else {
-            if (!devices_last_scan) devices_last_scan = std::chrono::high_resolution_clock::now();
-            if (std::chrono::duration_cast<std::chrono::seconds>(std::chrono::high_resolution_clock::now() - *devices_last_scan).count() >= 1) {
-                devices_future = async(std::launch::async, []() {
-                    return sc::firmware::mk4::discover(devices);
-                });
-            }
-        }
-        for (auto &device : devices) {
-            const auto contexts_i = std::find_if(device_contexts.begin(), device_contexts.end(), [&device](const std::shared_ptr<device_context> &context) {
-                return context->serial == device->serial;
-            });
-            if (contexts_i != device_contexts.end()) {
-                if (contexts_i->get()->handle.get() != device.get()) {
-                    spdlog::debug("Applied new handle to device context: {}", device->serial);
-                    contexts_i->get()->handle = device;
-                    contexts_i->get()->initial_communication_complete = false;
-                }
-                continue;
-            }
-            spdlog::debug("Created new device context: {}", device->serial);
-            auto new_device_context = std::make_shared<device_context>();
-            new_device_context->handle = device;
-            new_device_context->name = device->name;
-            new_device_context->serial = device->serial;
-            device_contexts.push_back(new_device_context);
-        }
-        for (auto &context : device_contexts) {
-            if (!context->handle) continue;
-            if (context->update_future.valid()) {
-                if (context->update_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
-                    const auto err = context->update_future.get();
-                    if (!err.has_value()) continue;
-                    spdlog::error("Device context error: {}", *err);
-                    devices.erase(std::remove_if(devices.begin(), devices.end(), [&](const std::shared_ptr<firmware::mk4::device_handle> &device) {
-                        return device.get() == context->handle.get();
-                    }), devices.end());
-                    context->initial_communication_complete = false;
-                    context->handle.reset();
-                } else continue;
-            }
-            context->update_future = async(std::launch::async, [context]() {
-                return device_context::update(context);
-            });
-        }
-    }
-
     static void emit_axis_profile_slice(const std::shared_ptr<device_context> &context, int axis_i) {
         const auto label_default = axis_i == 0 ? "Throttle" : (axis_i == 1 ? "Brake" : "Clutch");
         if (ImGui::BeginChild(fmt::format("##{}Window", label_default).data(), { 0, 0 }, true, ImGuiWindowFlags_MenuBar)) {
@@ -271,7 +208,7 @@ namespace sc::visor::gui {
                 ImGui::Text(fmt::format("{} {} Configurations", ICON_FA_COGS, label_default).data());
                 ImGui::EndMenuBar();
             }
-            if (ImGui::Button(context->axes[axis_i].enabled ? fmt::format("{} Disable", ICON_FA_STOP).data() : fmt::format("{} Enable", ICON_FA_PLAY).data(), { ImGui::GetContentRegionAvail().x, 0 })) context->handle->set_axis_enabled(axis_i, !context->axes[axis_i].enabled);
+            if (ImGui::Button(context->axes[axis_i].enabled ? fmt::format("{} Disable", ICON_FA_STOP).data() : fmt::format("{} Enable", ICON_FA_PLAY).data(), { ImGui::GetContentRegionAvail().x, 0 })) context->post(device_command::axis_enabled(axis_i, !context->axes[axis_i].enabled));
             if (ImGui::BeginChild("##{}InputRangeWindow", { 0, 164 }, true, ImGuiWindowFlags_MenuBar)) {
                 bool update_axis_range = false;
                 if (ImGui::BeginMenuBar()) {
@@ -334,11 +271,7 @@ namespace sc::visor::gui {
                         ImGui::EndTooltip();
                     }
                 }
-                if (update_axis_range) {
-                    const auto err = context->handle->set_axis_range(axis_i, context->axes_ex[axis_i].range_min, context->axes_ex[axis_i].range_max, context->axes_ex[axis_i].deadzone, context->axes_ex[axis_i].limit);
-                    if (err) spdlog::error(*err);
-                    else spdlog::info("Updated axis #{} range: {}, {}, {}", axis_i, context->axes_ex[axis_i].range_min, context->axes_ex[axis_i].range_max, context->axes_ex[axis_i].limit);
-                }
+                if (update_axis_range) context->post(device_command::axis_range(axis_i, context->axes_ex[axis_i].range_min, context->axes_ex[axis_i].range_max, context->axes_ex[axis_i].deadzone, context->axes_ex[axis_i].limit));
             }
             ImGui::EndChild();
             if (ImGui::BeginChild(fmt::format("##{}CurveWindow", label_default).data(), { 0, 294 }, true, ImGuiWindowFlags_MenuBar)) {
@@ -361,9 +294,7 @@ namespace sc::visor::gui {
                     ImGui::InputText("", context->models[context->axes_ex[axis_i].model_edit_i].label_buffer.data(), context->models[context->axes_ex[axis_i].model_edit_i].label_buffer.size());
                     ImGui::SameLine();
                     if (ImGui::Button("Set Label", { ImGui::GetContentRegionAvail().x, 0 })) {
-                        const auto err = context->handle->set_bezier_label(context->axes_ex[axis_i].model_edit_i, context->models[context->axes_ex[axis_i].model_edit_i].label_buffer.data());
-                        if (err) spdlog::error(*err);
-                        else context->models[context->axes_ex[axis_i].model_edit_i].label = context->models[context->axes_ex[axis_i].model_edit_i].label_buffer.data();
+                        if (context->post(device_command::bezier_label(context->axes_ex[axis_i].model_edit_i, context->models[context->axes_ex[axis_i].model_edit_i].label_buffer.data()))) context->models[context->axes_ex[axis_i].model_edit_i].label = context->models[context->axes_ex[axis_i].model_edit_i].label_buffer.data();
                     }
                     {
                         std::vector<glm::dvec2> model;
@@ -411,14 +342,10 @@ namespace sc::visor::gui {
                                 static_cast<float>(context->models[context->axes_ex[axis_i].model_edit_i].points[i].x) / 100.f,
                                 static_cast<float>(context->models[context->axes_ex[axis_i].model_edit_i].points[i].y) / 100.f
                             };
-                            const auto err = context->handle->set_bezier_model(context->axes_ex[axis_i].model_edit_i, model);
-                            if (err) spdlog::warn(*err);
-                            else spdlog::info("Model updated.");
+                            context->post(device_command::bezier_model(context->axes_ex[axis_i].model_edit_i, model));
                         }
-                        if (context->axes[axis_i].curve_i != context->axes_ex[axis_i].model_edit_i) {
-                            const auto err = context->handle->set_axis_bezier_index(axis_i, context->axes_ex[axis_i].model_edit_i);
-                            if (err) spdlog::warn(*err);
-                            else spdlog::info("Axis model index updated.");
+                        if (context->axes[axis_i].curve_i != context->axes_ex[axis_i].model_edit_i && context->axes_ex[axis_i].requested_curve_i != context->axes_ex[axis_i].model_edit_i) {
+                            if (context->post(device_command::axis_curve(axis_i, context->axes_ex[axis_i].model_edit_i))) context->axes_ex[axis_i].requested_curve_i = context->axes_ex[axis_i].model_edit_i;
                         }
                     }
                     ImGui::EndChild();
@@ -429,6 +356,133 @@ namespace sc::visor::gui {
         ImGui::EndChild();
     }
 
+    static void emit_aggregate_tab() {
+        if (service::devices().size() < 2 || !ImGui::BeginTabItem(fmt::format("{} Combined", ICON_FA_LINK).data())) return;
+        static std::optional<std::vector<aggregator::mapping>> editing;
+        if (!editing) editing = aggregator::get_mapping();
+        bool update_mapping = false;
+        const auto latest = aggregator::latest();
+        if (ImGui::BeginChild("##AggregateOutputs", { 200, 0 }, true, ImGuiWindowFlags_MenuBar)) {
+            if (ImGui::BeginMenuBar()) {
+                ImGui::Text(fmt::format("{} Outputs", ICON_FA_SITEMAP).data());
+                ImGui::EndMenuBar();
+            }
+            for (int i = 0; i < latest.axes.size(); i++) {
+                if (!latest.present[i]) continue;
+                ImGui::TextDisabled(fmt::format("Axis #{}", i + 1).data());
+                ImGui::ProgressBar(latest.axes[i], { ImGui::GetContentRegionAvail().x, 8 }, "");
+            }
+        }
+        ImGui::EndChild();
+        ImGui::SameLine(0, ImGui::GetStyle().FramePadding.x);
+        if (ImGui::BeginChild("##AggregateMapping", { 0, 0 }, true, ImGuiWindowFlags_MenuBar)) {
+            if (ImGui::BeginMenuBar()) {
+                ImGui::Text(fmt::format("{} Mapping", ICON_FA_COGS).data());
+                ImGui::EndMenuBar();
+            }
+            for (int i = 0; i < editing->size(); i++) {
+                auto &entry = editing->at(i);
+                ImGui::PushID(i);
+                ImGui::SetNextItemWidth(160);
+                if (ImGui::BeginCombo("##Source", entry.serial.size() ? entry.serial.data() : "None selected.")) {
+                    for (const auto &context : service::devices()) {
+                        if (ImGui::Selectable(fmt::format("{} (#{})", context->name, context->serial).data())) {
+                            entry.serial = context->serial;
+                            update_mapping = true;
+                        }
+                    }
+                    ImGui::EndCombo();
+                }
+                ImGui::SameLine();
+                ImGui::PushItemWidth(80);
+                if (ImGui::InputInt("Axis", &entry.source_axis_i)) update_mapping = true;
+                ImGui::SameLine();
+                if (ImGui::InputInt("Output", &entry.logical_axis_i)) update_mapping = true;
+                ImGui::PopItemWidth();
+                ImGui::SameLine();
+                if (ImGui::Button(ICON_FA_TRASH)) {
+                    editing->erase(editing->begin() + i);
+                    update_mapping = true;
+                }
+                ImGui::PopID();
+            }
+            if (ImGui::Button(fmt::format("{} Add", ICON_FA_PLUS).data())) {
+                editing->push_back({ });
+                update_mapping = true;
+            }
+            ImGui::SameLine();
+            if (ImGui::Button(fmt::format("{} Save", ICON_FA_SAVE).data())) {
+                if (const auto err = aggregator::save_settings(); err) spdlog::error("Unable to save combined device settings: {}", *err);
+                else spdlog::info("Combined device settings saved.");
+            }
+        }
+        ImGui::EndChild();
+        if (update_mapping) aggregator::set_mapping(*editing);
+        ImGui::EndTabItem();
+    }
+
+    static std::string format_duration(const std::chrono::nanoseconds &duration) {
+        if (duration < std::chrono::microseconds(1)) return fmt::format("{}ns", duration.count());
+        if (duration < std::chrono::milliseconds(1)) return fmt::format("{:.1f}us", duration.count() / 1000.0);
+        return fmt::format("{:.2f}ms", duration.count() / 1000000.0);
+    }
+
+    static void emit_diagnostics_tab() {
+        if (!ImGui::BeginTabItem(fmt::format("{} Diagnostics", ICON_FA_STETHOSCOPE).data())) return;
+        if (ImGui::Button(fmt::format("{} Export", ICON_FA_FILE_EXPORT).data())) {
+            if (const auto err = diagnostics::export_to("lock-contention.json"); err) spdlog::error("Unable to export lock contention: {}", *err);
+            else spdlog::info("Exported lock contention to lock-contention.json");
+        }
+        ImGui::SameLine();
+        if (ImGui::Button(fmt::format("{} Reset", ICON_FA_ERASER).data())) diagnostics::reset();
+        static std::optional<int> selected_site_i;
+        const auto sites = diagnostics::sites();
+        if (ImGui::BeginTable("##LockContentionTable", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY, { 0, 240 })) {
+            ImGui::TableSetupColumn("Lock");
+            ImGui::TableSetupColumn("Call Site");
+            ImGui::TableSetupColumn("Count");
+            ImGui::TableSetupColumn("Wait p50");
+            ImGui::TableSetupColumn("Wait p99");
+            ImGui::TableSetupColumn("Wait Max");
+            ImGui::TableSetupColumn("Hold p99");
+            ImGui::TableSetupColumn("Hold Max");
+            ImGui::TableHeadersRow();
+            for (int i = 0; i < sites.size(); i++) {
+                const auto &site = *sites[i];
+                if (site.wait.count == 0) continue;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                if (ImGui::Selectable(fmt::format("{}##LockSite{}", site.lock_name, i).data(), selected_site_i == i, ImGuiSelectableFlags_SpanAllColumns)) selected_site_i = i;
+                ImGui::TableNextColumn();
+                ImGui::TextDisabled(fmt::format("{}:{}", std::filesystem::path(site.file).filename().string(), site.line).data());
+                ImGui::TableNextColumn();
+                ImGui::Text(fmt::format("{}", site.wait.count.load()).data());
+                ImGui::TableNextColumn();
+                ImGui::Text(format_duration(site.wait.percentile(.5)).data());
+                ImGui::TableNextColumn();
+                ImGui::Text(format_duration(site.wait.percentile(.99)).data());
+                ImGui::TableNextColumn();
+                ImGui::Text(format_duration(std::chrono::nanoseconds(site.wait.max_ns.load())).data());
+                ImGui::TableNextColumn();
+                ImGui::Text(format_duration(site.hold.percentile(.99)).data());
+                ImGui::TableNextColumn();
+                ImGui::Text(format_duration(std::chrono::nanoseconds(site.hold.max_ns.load())).data());
+            }
+            ImGui::EndTable();
+        }
+        if (selected_site_i && *selected_site_i < sites.size()) {
+            const auto &site = *sites[*selected_site_i];
+            std::array<float, diagnostics::histogram::num_buckets> wait_buckets, hold_buckets;
+            for (int i = 0; i < diagnostics::histogram::num_buckets; i++) {
+                wait_buckets[i] = static_cast<float>(site.wait.buckets[i].load());
+                hold_buckets[i] = static_cast<float>(site.hold.buckets[i].load());
+            }
+            ImGui::PlotHistogram("Wait (log2 us)", wait_buckets.data(), wait_buckets.size(), 0, nullptr, 0, FLT_MAX, { ImGui::GetContentRegionAvail().x - 120, 80 });
+            ImGui::PlotHistogram("Hold (log2 us)", hold_buckets.data(), hold_buckets.size(), 0, nullptr, 0, FLT_MAX, { ImGui::GetContentRegionAvail().x - 120, 80 });
+        }
+        ImGui::EndTabItem();
+    }
+
     static void emit_content_device_panel() {
         animation_under_construction.play = false;
         animation_under_construction.playing = false;
@@ -756,13 +810,13 @@ namespace sc::visor::gui {
                     button,
                     hat
                 };
-                if (device_contexts.size() || enable_legacy_support) {
+                if (service::devices().size() || service::legacy_enabled()) {
                     animation_scan.playing = false;
                     if (ImGui::BeginTabBar("##DeviceTabBar")) {
-                        for (const auto &context : device_contexts) {
-                            std::lock_guard guard(context->mutex);
+                        for (const auto &context : service::devices()) {
+                            SC_LOCK_GUARD(context->mutex);
                             if (ImGui::BeginTabItem(fmt::format("{} {}##{}", ICON_FA_MICROCHIP, context->name, context->serial).data())) {
-                                if (context->handle) {
+                                if (context->connected) {
                                     ImGui::TextColored({ .2f, 1, .2f, 1 }, fmt::format("{} Connected", ICON_FA_CHECK_DOUBLE).data());
                                     ImGui::SameLine();
                                     ImGui::TextDisabled(fmt::format("v{}.{}.{}", context->version_major, context->version_minor, context->version_revision).data());
@@ -775,11 +829,7 @@ namespace sc::visor::gui {
                                             ImGui::Text(fmt::format("{} Controls", ICON_FA_SATELLITE_DISH).data());
                                             ImGui::EndMenuBar();
                                         }
-                                        if (ImGui::Button(fmt::format("{} Save to Chip", ICON_FA_FILE_IMPORT).data(), { ImGui::GetContentRegionAvail().x, 0 })) {
-                                            const auto err = context->handle->commit();
-                                            if (err) spdlog::error(*err);
-                                            else spdlog::info("Settings saved.");
-                                        }
+                                        if (ImGui::Button(fmt::format("{} Save to Chip", ICON_FA_FILE_IMPORT).data(), { ImGui::GetContentRegionAvail().x, 0 })) context->post(device_command::save());
                                         if (ImGui::Button(fmt::format("{} Clear Chip", ICON_FA_ERASER).data(), { ImGui::GetContentRegionAvail().x, 0 }));
                                     }
                                     ImGui::EndChild();
@@ -827,13 +877,39 @@ namespace sc::visor::gui {
                                 ImGui::EndTabItem();
                             }
                         }
-                        if (enable_legacy_support && ImGui::BeginTabItem(fmt::format("{} Virtual Pedals", ICON_FA_GHOST).data())) {
-                            if (legacy::present()) ImGui::TextColored({ .2f, 1, .2f, 1 }, fmt::format("{} Online", ICON_FA_CHECK_DOUBLE).data());
-                            else {
+                        emit_aggregate_tab();
+                        if (service::legacy_enabled() && ImGui::BeginTabItem(fmt::format("{} Virtual Pedals", ICON_FA_GHOST).data())) {
+                            if (legacy::present()) {
+                                ImGui::TextColored({ .2f, 1, .2f, 1 }, fmt::format("{} Online", ICON_FA_CHECK_DOUBLE).data());
+                                ImGui::SameLine();
+                                const auto pipeline = legacy::latest();
+                                ImGui::TextDisabled(fmt::format("{:.0f} Hz, {:.0f} reports/s, {} suppressed", pipeline.rate_hz, pipeline.submissions_per_second, pipeline.num_suppressed).data());
+                                const auto &latency = legacy::latency();
+                                if (ImGui::IsItemHovered() && latency.end_to_end.count > 0) {
+                                    const auto to_ms = [](const std::chrono::nanoseconds &ns) {
+                                        return std::chrono::duration<float, std::milli>(ns).count();
+                                    };
+                                    ImGui::BeginTooltip();
+                                    ImGui::Text(fmt::format("Input to process: p50 {:.2f} ms, p99 {:.2f} ms", to_ms(latency.acquire_to_process.percentile(.5)), to_ms(latency.acquire_to_process.percentile(.99))).data());
+                                    ImGui::Text(fmt::format("Process to submit: p50 {:.2f} ms, p99 {:.2f} ms", to_ms(latency.process_to_submit.percentile(.5)), to_ms(latency.process_to_submit.percentile(.99))).data());
+                                    ImGui::Text(fmt::format("Input to output: p50 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms", to_ms(latency.end_to_end.percentile(.5)), to_ms(latency.end_to_end.percentile(.99)), to_ms(std::chrono::nanoseconds(latency.end_to_end.max_ns.load()))).data());
+                                    ImGui::EndTooltip();
+                                }
+                            } else {
                                 ImGui::TextColored({ .2f, 1, .2f, 1 }, fmt::format("{} Ready", ICON_FA_CHECK).data());
                                 ImGui::SameLine();
                                 ImGui::TextDisabled("No hardware detected.");
                             }
+                            if (const auto profiles = legacy::profile_names(); profiles.size() > 1) {
+                                ImGui::SameLine();
+                                ImGui::SetNextItemWidth(160);
+                                if (ImGui::BeginCombo("##VirtualPedalProfile", profiles[legacy::active_profile()].data())) {
+                                    for (size_t i = 0; i < profiles.size(); i++) {
+                                        if (ImGui::Selectable(profiles[i].data(), i == legacy::active_profile())) legacy::activate_profile(i);
+                                    }
+                                    ImGui::EndCombo();
+                                }
+                            }
                             const auto top_y = ImGui::GetCursorScreenPos().y;
                             if (ImGui::BeginChild("##DeviceInteractionBox", { 200, 86 }, true, ImGuiWindowFlags_MenuBar)) {
                                 if (ImGui::BeginMenuBar()) {
@@ -890,7 +966,7 @@ namespace sc::visor::gui {
                                         legacy::axes[current_selection].label = trimmed;
                                     } else legacy::axes[current_selection].label.reset();
                                 }
-                                if (ImGui::BeginChild("##{}InputRangeWindow", { 0, 164 }, true, ImGuiWindowFlags_MenuBar)) {
+                                if (ImGui::BeginChild("##{}InputRangeWindow", { 0, 216 }, true, ImGuiWindowFlags_MenuBar)) {
                                     bool update_axis_range = false;
                                     if (ImGui::BeginMenuBar()) {
                                         ImGui::Text(fmt::format("{} Range", ICON_FA_RULER).data());
@@ -924,6 +1000,54 @@ namespace sc::visor::gui {
                                         ImGui::Text("Set the maximum range to the current raw input value.");
                                         ImGui::EndTooltip();
                                     }
+                                    static std::optional<std::string> calibration_error;
+                                    if (const auto calibrating_axis = legacy::calibrating_axis(); calibrating_axis && *calibrating_axis == current_selection) {
+                                        if (ImGui::Button(fmt::format(" {} Finish Sweep ", ICON_FA_CHECK).data(), { 140, 0 })) calibration_error = legacy::finish_calibration();
+                                        ImGui::SameLine();
+                                        if (ImGui::Button(fmt::format(" {} Cancel ", ICON_FA_TIMES).data(), { 100, 0 })) legacy::cancel_calibration();
+                                        ImGui::SameLine();
+                                        ImGui::TextDisabled(fmt::format("Recording sweep: {} samples", legacy::calibration_samples()).data());
+                                    } else {
+                                        if (ImGui::Button(fmt::format(" {} Calibrate Sweep ", ICON_FA_CHART_LINE).data(), { 140, 0 })) {
+                                            calibration_error.reset();
+                                            legacy::begin_calibration(current_selection);
+                                        }
+                                        if (ImGui::IsItemHovered()) {
+                                            ImGui::BeginTooltip();
+                                            ImGui::Text("Record a steady press through the full pedal travel to linearize its sensor. Only the press stroke is recorded, so resting or holding the pedal does not skew the result.");
+                                            ImGui::EndTooltip();
+                                        }
+                                        if (legacy::calibrated(current_selection)) {
+                                            ImGui::SameLine();
+                                            if (ImGui::Button(fmt::format(" {} Clear Calibration ", ICON_FA_ERASER).data(), { 160, 0 })) calibration_error = legacy::clear_calibration(current_selection);
+                                        }
+                                        if (calibration_error) {
+                                            ImGui::SameLine();
+                                            ImGui::TextColored({ 1, .2f, .2f, 1 }, calibration_error->data());
+                                        }
+                                    }
+                                    auto auto_range_i = static_cast<int>(legacy::axes[current_selection].auto_range);
+                                    ImGui::SetNextItemWidth(140);
+                                    if (ImGui::Combo("Auto Range", &auto_range_i, "Off\0Propose\0Apply\0")) legacy::axes[current_selection].auto_range = static_cast<legacy::auto_range_mode>(auto_range_i);
+                                    if (ImGui::IsItemHovered()) {
+                                        ImGui::BeginTooltip();
+                                        ImGui::Text("Track the resting and fully pressed positions while driving and propose or apply them as the range.");
+                                        ImGui::EndTooltip();
+                                    }
+                                    if (legacy::axes[current_selection].auto_range != legacy::auto_range_mode::off) {
+                                        ImGui::SameLine();
+                                        if (const auto &proposed = legacy::axes[current_selection].proposed_range; proposed) {
+                                            ImGui::TextDisabled(fmt::format("Observed: {} .. {}", proposed->x, proposed->y).data());
+                                            if (legacy::axes[current_selection].auto_range == legacy::auto_range_mode::propose) {
+                                                ImGui::SameLine();
+                                                if (ImGui::SmallButton("Use##AutoRangeUseButton")) {
+                                                    legacy::axes[current_selection].output_steps_min = proposed->x;
+                                                    legacy::axes[current_selection].output_steps_max = proposed->y;
+                                                    update_axis_range = true;
+                                                }
+                                            }
+                                        } else ImGui::TextDisabled("Collecting samples...");
+                                    }
                                     if (ImGui::SliderInt("Deadzone", &legacy::axes[current_selection].deadzone, 0, 30, "%d%%")) update_axis_range = true;
                                     if (ImGui::SliderInt("Output Limit##DZH", &legacy::axes[current_selection].output_limit, 50, 100, "%d%%")) update_axis_range = true;
                                     if (!legacy::axes[current_selection].present) ImGui::PushStyleColor(ImGuiCol_FrameBg, { 72.f / 255.f, 42.f / 255.f, 42.f / 255.f, 1.f });
@@ -976,6 +1100,21 @@ namespace sc::visor::gui {
                                         if (ImGui::Button("Set Label", { ImGui::GetContentRegionAvail().x, 0 })) {
                                             legacy::models[legacy::axes[current_selection].model_edit_i].label = legacy::models[legacy::axes[current_selection].model_edit_i].label_buffer.data();
                                         }
+                                        auto &edit_model = legacy::models[legacy::axes[current_selection].model_edit_i];
+                                        if (ImGui::BeginCombo(fmt::format("##Axis{}CurveKind", current_selection).data(), edit_model.type == pedals::curve_kind::spline ? "Monotone Spline" : "Bezier")) {
+                                            if (ImGui::Selectable("Bezier", edit_model.type == pedals::curve_kind::bezier) && edit_model.type != pedals::curve_kind::bezier) {
+                                                std::vector<glm::dvec2> knots;
+                                                for (const auto &point : edit_model.points) knots.push_back({ point.x / 100.0, point.y / 100.0 });
+                                                const auto spline = pedals::monotone_spline::fit(knots);
+                                                edit_model.points = legacy::model().points;
+                                                for (auto &point : edit_model.points) point.y = glm::clamp(static_cast<int>(glm::round(spline.evaluate(point.x / 100.0) * 100.0)), 0, 100);
+                                                edit_model.type = pedals::curve_kind::bezier;
+                                            }
+                                            if (ImGui::Selectable("Monotone Spline", edit_model.type == pedals::curve_kind::spline)) edit_model.type = pedals::curve_kind::spline;
+                                            ImGui::EndCombo();
+                                        }
+                                        ImGui::SameLine();
+                                        ImGui::Text("Curve Type");
                                         {
                                             std::vector<glm::dvec2> model;
                                             for (auto &percent : legacy::models[legacy::axes[current_selection].model_edit_i].points) model.push_back({
@@ -985,13 +1124,37 @@ namespace sc::visor::gui {
                                             const int deadzone_padding = (legacy::axes[current_selection].deadzone / 100.f) * static_cast<float>(legacy::axes[current_selection].output_steps_max - legacy::axes[current_selection].output_steps_min);
                                             auto cif = glm::max(0.0, static_cast<double>(legacy::axes[current_selection].input_steps - (legacy::axes[current_selection].output_steps_min + deadzone_padding)) / static_cast<double>(legacy::axes[current_selection].output_steps_max - (legacy::axes[current_selection].output_steps_min + deadzone_padding)));
                                             if (cif > 1.0) cif = 1.0;
-                                            if (legacy::axes[current_selection].model_edit_i == legacy::axes[current_selection].curve_i) bezier::ui::plot_cubic(model, { 200, 200 }, legacy::axes[current_selection].output, std::nullopt, legacy::axes[current_selection].output_limit / 100.f, cif);
-                                            else bezier::ui::plot_cubic(model, { 200, 200 }, std::nullopt, std::nullopt, legacy::axes[current_selection].output_limit / 100.f, cif);
+                                            const auto plot = edit_model.type == pedals::curve_kind::spline ? bezier::ui::plot_spline : bezier::ui::plot_cubic;
+                                            if (legacy::axes[current_selection].model_edit_i == legacy::axes[current_selection].curve_i) plot(model, { 200, 200 }, legacy::axes[current_selection].output, std::nullopt, legacy::axes[current_selection].output_limit / 100.f, cif);
+                                            else plot(model, { 200, 200 }, std::nullopt, std::nullopt, legacy::axes[current_selection].output_limit / 100.f, cif);
                                         }
                                         ImGui::SameLine();
                                         if (ImGui::BeginChild(fmt::format("##Axis{}CurveWindowRightPanel", current_selection).data(), { ImGui::GetContentRegionAvail().x, ImGui::GetContentRegionAvail().y }, false)) {
                                             ImGui::PushItemWidth(80);
-                                            for (int i = 0; i < legacy::models[legacy::axes[current_selection].model_edit_i].points.size(); i++) {
+                                            if (edit_model.type == pedals::curve_kind::spline) {
+                                                std::optional<int> removed_i;
+                                                for (int i = 0; i < edit_model.points.size(); i++) {
+                                                    const auto first = i == 0, last = i == edit_model.points.size() - 1;
+                                                    if (first || last) ImGui::TextDisabled(first ? "0%%" : "100%%");
+                                                    else ImGui::SliderInt(fmt::format("X##SX{}", i + 1).data(), &edit_model.points[i].x, edit_model.points[i - 1].x + 1, edit_model.points[i + 1].x - 1);
+                                                    ImGui::SameLine();
+                                                    ImGui::SliderInt(fmt::format("Y##SY{}", i + 1).data(), &edit_model.points[i].y, 0, 100);
+                                                    if (first || last) continue;
+                                                    ImGui::SameLine();
+                                                    if (ImGui::Button(fmt::format("{}##SR{}", ICON_FA_TIMES, i + 1).data())) removed_i = i;
+                                                }
+                                                if (removed_i) edit_model.points.erase(edit_model.points.begin() + *removed_i);
+                                                if (edit_model.points.size() < legacy::model::max_points && ImGui::Button(fmt::format("{} Add Point", ICON_FA_PLUS).data())) {
+                                                    size_t gap_i = 0;
+                                                    for (size_t i = 1; i + 1 < edit_model.points.size(); i++) {
+                                                        if (edit_model.points[i + 1].x - edit_model.points[i].x > edit_model.points[gap_i + 1].x - edit_model.points[gap_i].x) gap_i = i;
+                                                    }
+                                                    if (edit_model.points[gap_i + 1].x - edit_model.points[gap_i].x >= 2) {
+                                                        edit_model.points.insert(edit_model.points.begin() + gap_i + 1, (edit_model.points[gap_i] + edit_model.points[gap_i + 1]) / 2);
+                                                    }
+                                                }
+                                            }
+                                            for (int i = 0; edit_model.type == pedals::curve_kind::bezier && i < legacy::models[legacy::axes[current_selection].model_edit_i].points.size(); i++) {
                                                 if (i == 0 || i == legacy::models[legacy::axes[current_selection].model_edit_i].points.size() - 1) continue;
                                                 switch (i) {
                                                     case 1: ImGui::TextDisabled("20%%"); break;
@@ -1045,6 +1208,7 @@ namespace sc::visor::gui {
                 }
                 ImGui::EndTabItem();
             }
+            emit_diagnostics_tab();
             /*
             if (ImGui::BeginTabItem(fmt::format("{} iRacing", ICON_FA_FLAG_CHECKERED).data())) {
                 ImGui::Text(fmt::format("Status: {}", magic_enum::enum_name(iracing::get_status())).data());
@@ -1055,16 +1219,6 @@ namespace sc::visor::gui {
         }
     }
 
-    static void try_toggle_legacy_support() {
-        if (enable_legacy_support) {
-            legacy::disable();
-            enable_legacy_support = false;
-        } else if (const auto err = legacy::enable(); err) {
-            legacy_support_error = true;
-            legacy_support_error_description = *err;
-        } else enable_legacy_support = true;
-    }
-
     static void emit_primary_window_menu_bar() {
         if (ImGui::BeginMenuBar()) {
             if (ImGui::BeginMenu(fmt::format("{} File", ICON_FA_SAVE).data())) {
@@ -1119,10 +1273,10 @@ namespace sc::visor::gui {
         ImGui::SetNextWindowSize({ 400, 200 }, ImGuiCond_Always);
         // ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, { 12, 12 });
         ImGui::PushStyleColor(ImGuiCol_TitleBgActive, { 90.f / 255.f, 12.f / 255.f, 12.f / 255.f, 1.f });
-        if (ImGui::BeginPopupModal(legacy_is_default ? "Hardware Enablement Error" : "Legacy Hardware Enablement Error", nullptr, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove)) {
+        if (ImGui::BeginPopupModal(service::legacy_is_default ? "Hardware Enablement Error" : "Legacy Hardware Enablement Error", nullptr, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove)) {
             ImGui::TextWrapped(fmt::format(
                 "{} support was unable to be activated. There are additional drivers required for this functionality. Make sure they're installed.",
-                legacy_is_default ? "Hardware" : "Legacy hardware"
+                service::legacy_is_default ? "Hardware" : "Legacy hardware"
             ).data());
             ImGui::NewLine();
             {
@@ -1164,12 +1318,9 @@ void sc::visor::gui::initialize() {
     load_animations();
     animation_scan.loop = true;
     animation_comm.loop = true;
-    if (legacy_is_default) try_toggle_legacy_support();
 }
 
 void sc::visor::gui::shutdown() {
-    devices_future = { };
-    devices.clear();
     animation_scan.frames.clear();
     animation_comm.frames.clear();
     animation_under_construction.frames.clear();
@@ -1193,8 +1344,7 @@ void sc::visor::gui::emit(const glm::ivec2 &framebuffer_size, bool *const force_
     emit_legacy_hardware_enablement_error_popup(framebuffer_size);
     if (legacy_support_error) {
         spdlog::error("Legacy support experienced an error.");
-        ImGui::OpenPopup(legacy_is_default ? "Hardware Enablement Error" : "Legacy Hardware Enablement Error");
+        ImGui::OpenPopup(service::legacy_is_default ? "Hardware Enablement Error" : "Legacy Hardware Enablement Error");
         legacy_support_error = false;
     }
-    poll_devices();
 }
\ No newline at end of file
@@ -1,6 +1,14 @@
 #include "legacy.h"
 
+#include <algorithm>
 #include <optional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
 
 #include <spdlog/spdlog.h>
 
@@ -8,18 +16,23 @@
 
 #include <windows.h>
 #include <Xinput.h>
+#include <mmsystem.h>
 
-#include <GLFW/glfw3.h>
 #include <nlohmann/json.hpp>
 
 #include "../../libs/hidhide/hidhide.h"
-#include "../../libs/vigem/client.h"
+#include "../../libs/input/input.h"
+#include "../../libs/sink/gate.h"
+#include "../../libs/defer.hpp"
 
 #include <glm/common.hpp>
 
-#include "bezier.h"
+#include "../../libs/pedals/pipeline.h"
 
 #include "../../libs/file/file.h"
+#include "../../libs/process/process.h"
+#include "../../libs/pacer.hpp"
+#include "../../libs/seqlock.hpp"
 
 #undef min
 #undef max
@@ -29,12 +42,73 @@ std::array<sc::visor::legacy::model, 5> sc::visor::legacy::models;
 
 namespace sc::visor::legacy {
 
-    static std::optional<PVIGEM_CLIENT> vigem_client;
-    static std::optional<PVIGEM_TARGET> vigem_gamepad;
-    static std::optional<DS4_REPORT> vigem_gamepad_report;
+    static std::unique_ptr<input::source> source;
+    static std::unique_ptr<sink::change_gate> output;
+
+    struct pipeline_settings {
+
+        struct axis {
+
+            int output_steps_min, output_steps_max;
+            int deadzone, output_limit;
+            int curve_i;
+            pedals::filter_chain::settings filters;
+            auto_range_mode auto_range;
+        };
+
+        struct model {
+
+            pedals::curve_kind type;
+            int num_points;
+            std::array<glm::ivec2, legacy::model::max_points> points;
+        };
+
+        std::array<axis, std::tuple_size<decltype(legacy::axes)>::value> axes;
+        std::array<model, std::tuple_size<decltype(legacy::models)>::value> models;
+    };
+
+    struct compiled_settings {
+
+        pipeline_settings settings;
+        pedals::axis_batch batch;
+    };
+
+    struct profile {
+
+        std::string name;
+        std::filesystem::path path;
+        std::vector<std::string> processes;
+        decltype(legacy::axes) axes;
+        decltype(legacy::models) models;
+    };
+
+    static_assert(std::tuple_size<decltype(axes)>::value == pedals::axis_batch::lanes, "each virtual axis needs a batch lane");
 
     static bool found_legacy_hardware = false;
 
+    static std::thread worker;
+    static std::atomic_bool working = false;
+    static std::atomic_bool report_failed = false;
+    static std::atomic_int rate_hz = 1000;
+    static std::atomic_int keep_alive_ms = 250;
+    static std::mutex compiled_mutex;
+    static std::shared_ptr<const compiled_settings> compiled;
+    static std::atomic<uint64_t> compiled_generation = 0;
+    static seqlock<snapshot> published_state;
+    static pedals::latency_stats latency_stats;
+    static pedals::calibration_recorder calibration_recorder;
+    static std::atomic_int calibration_axis = -1;
+    static std::mutex calibration_mutex;
+    static std::shared_ptr<const pedals::calibration_set> calibration;
+    static std::atomic<uint64_t> calibration_generation = 0, calibration_applied = 0;
+    static const std::filesystem::path calibration_path = "virtual-pedals-calibration.bin";
+    static const std::filesystem::path settings_path = "virtual-pedals.json";
+    static const std::filesystem::path profiles_path = "virtual-pedals-profiles";
+    static std::vector<profile> profiles;
+    static size_t active_profile_i = 0;
+    static std::unique_ptr<process::monitor> games;
+    static std::optional<uint64_t> games_generation;
+
     static std::optional<std::filesystem::path> get_module_file_path() {
         TCHAR path[MAX_PATH];
         if (GetModuleFileNameA(NULL, path, sizeof(path)) == 0) return std::nullopt;
@@ -92,6 +166,356 @@ namespace sc::visor::legacy {
         } else return "Unable to get HIDHIDE blacklist.";
         return std::nullopt;
     }
+
+    static constexpr std::array<std::string_view, 3> auto_range_names = { "off", "propose", "apply" };
+    static constexpr int auto_range_hysteresis = 5;
+
+    static constexpr std::array<std::string_view, 5> filter_names = { "none", "ema", "median", "one_euro", "slew" };
+
+    static nlohmann::json filters_to_json(const pedals::filter_chain::settings &filters) {
+        nlohmann::json doc = nlohmann::json::array();
+        for (const auto &stage : filters) {
+            switch (stage.type) {
+                case pedals::filter_stage::kind::ema:
+                    doc.push_back({ { "type", "ema" }, { "alpha", stage.alpha } });
+                    break;
+                case pedals::filter_stage::kind::median:
+                    doc.push_back({ { "type", "median" }, { "window", stage.window } });
+                    break;
+                case pedals::filter_stage::kind::one_euro:
+                    doc.push_back({ { "type", "one_euro" }, { "min_cutoff", stage.min_cutoff }, { "beta", stage.beta }, { "derivative_cutoff", stage.derivative_cutoff } });
+                    break;
+                case pedals::filter_stage::kind::slew:
+                    doc.push_back({ { "type", "slew" }, { "max_rate", stage.max_rate } });
+                    break;
+                default:
+                    break;
+            }
+        }
+        return doc;
+    }
+
+    static pedals::filter_chain::settings filters_from_json(const nlohmann::json &doc) {
+        pedals::filter_chain::settings filters;
+        size_t stage_i = 0;
+        for (const auto &stage_doc : doc) {
+            if (stage_i >= filters.size()) break;
+            if (!stage_doc.is_object()) continue;
+            const auto name = stage_doc.value("type", std::string("none"));
+            const auto type_i = std::find(filter_names.begin(), filter_names.end(), name) - filter_names.begin();
+            if (type_i <= 0 || type_i >= filter_names.size()) continue;
+            auto &stage = filters[stage_i++];
+            stage.type = static_cast<pedals::filter_stage::kind>(type_i);
+            stage.alpha = stage_doc.value("alpha", stage.alpha);
+            stage.window = stage_doc.value("window", stage.window);
+            stage.min_cutoff = stage_doc.value("min_cutoff", stage.min_cutoff);
+            stage.beta = stage_doc.value("beta", stage.beta);
+            stage.derivative_cutoff = stage_doc.value("derivative_cutoff", stage.derivative_cutoff);
+            stage.max_rate = stage_doc.value("max_rate", stage.max_rate);
+        }
+        return filters;
+    }
+
+    static void publish_settings();
+
+    static nlohmann::json profile_to_json(const decltype(legacy::axes) &axes, const decltype(legacy::models) &models) {
+        nlohmann::json doc, axes_doc;
+        for (int i = 0; i < axes.size(); i++) {
+            nlohmann::json axis_doc;
+            axis_doc["min"] = axes[i].output_steps_min;
+            axis_doc["max"] = axes[i].output_steps_max;
+            axis_doc["deadzone"] = axes[i].deadzone;
+            axis_doc["limit"] = axes[i].output_limit;
+            if (axes[i].curve_i != -1) axis_doc["curve"] = axes[i].curve_i;
+            if (axes[i].label) axis_doc["label"] = axes[i].label->data();
+            if (const auto filters_doc = filters_to_json(axes[i].filters); !filters_doc.empty()) axis_doc["filters"] = filters_doc;
+            if (axes[i].auto_range != auto_range_mode::off) axis_doc["auto_range"] = auto_range_names[static_cast<size_t>(axes[i].auto_range)];
+            axes_doc.push_back(axis_doc);
+        }
+        doc["axes"] = axes_doc;
+        nlohmann::json models_doc;
+        for (int i = 0; i < models.size(); i++) {
+            nlohmann::json model_doc;
+            if (models[i].label) model_doc["label"] = *models[i].label;
+            if (models[i].type == pedals::curve_kind::spline) model_doc["type"] = "spline";
+            nlohmann::json points_doc;
+            for (int j = 0; j < models[i].points.size(); j++) {
+                nlohmann::json point_doc = {
+                    { "x", models[i].points[j].x },
+                    { "y", models[i].points[j].y }
+                };
+                points_doc.push_back(point_doc);
+            }
+            model_doc["points"] = points_doc;
+            models_doc.push_back(model_doc);
+        }
+        doc["models"] = models_doc;
+        return doc;
+    }
+
+    static void profile_from_json(const nlohmann::json &doc, decltype(legacy::axes) &axes, decltype(legacy::models) &models) {
+        if (auto axes_doc = doc.find("axes"); axes_doc != doc.end() && axes_doc->is_array()) {
+            for (int i = 0; i < glm::min(axes_doc->size(), axes.size()); i++) {
+                axes[i].output_steps_min = axes_doc->at(i).value("min", 0);
+                axes[i].output_steps_max = axes_doc->at(i).value("max", 100);
+                axes[i].deadzone = axes_doc->at(i).value("deadzone", 0);
+                axes[i].output_limit = axes_doc->at(i).value("limit", 100);
+                axes[i].curve_i = axes_doc->at(i).value("curve", -1);
+                axes[i].model_edit_i = axes[i].curve_i;
+                if (axes_doc->at(i).find("label") != axes_doc->at(i).end()) axes[i].label = axes_doc->at(i)["label"];
+                if (auto filters_doc = axes_doc->at(i).find("filters"); filters_doc != axes_doc->at(i).end() && filters_doc->is_array()) axes[i].filters = filters_from_json(*filters_doc);
+                else axes[i].filters = { };
+                const auto auto_range = axes_doc->at(i).value("auto_range", std::string("off"));
+                const auto auto_range_i = std::find(auto_range_names.begin(), auto_range_names.end(), auto_range) - auto_range_names.begin();
+                axes[i].auto_range = static_cast<size_t>(auto_range_i) < auto_range_names.size() ? static_cast<auto_range_mode>(auto_range_i) : auto_range_mode::off;
+            }
+        }
+        if (auto models_doc = doc.find("models"); models_doc != doc.end() && models_doc->is_array()) {
+            for (int i = 0; i < glm::min(models_doc->size(), models.size()); i++) {
+                auto model_doc = models_doc->at(i);
+                if (auto label = model_doc.find("label"); label != model_doc.end() && label->is_string()) {
+                    models[i].label = *label;
+                    strcpy_s(models[i].label_buffer.data(), models[i].label_buffer.size(), models[i].label->data());
+                }
+                models[i].type = model_doc.value("type", std::string("bezier")) == "spline" ? pedals::curve_kind::spline : pedals::curve_kind::bezier;
+                if (auto points_doc = model_doc.find("points"); points_doc != model_doc.end() && points_doc->is_array()) {
+                    if (models[i].type == pedals::curve_kind::spline) models[i].points.resize(glm::clamp(points_doc->size(), static_cast<size_t>(2), model::max_points));
+                    else if (models[i].points.size() != model().points.size()) models[i].points = model().points;
+                    for (int j = 0; j < glm::min(points_doc->size(), models[i].points.size()); j++) {
+                        models[i].points[j].x = points_doc->at(j).value("x", 0);
+                        models[i].points[j].y = points_doc->at(j).value("y", 0);
+                    }
+                }
+            }
+        }
+    }
+
+    static tl::expected<profile, std::string> load_profile(const std::filesystem::path &path) {
+        const auto load_res = file::load(path);
+        if (!load_res.has_value()) return tl::make_unexpected(load_res.error());
+        try {
+            const auto doc = nlohmann::json::parse(*load_res);
+            profile result { doc.value("name", path.stem().string()), path, { }, axes, models };
+            if (auto processes_doc = doc.find("processes"); processes_doc != doc.end() && processes_doc->is_array()) {
+                for (const auto &name : *processes_doc) {
+                    if (name.is_string()) result.processes.push_back(name);
+                }
+            }
+            profile_from_json(doc, result.axes, result.models);
+            return result;
+        } catch (const nlohmann::json::exception &exc) {
+            return tl::make_unexpected(exc.what());
+        }
+    }
+
+    static void load_profiles() {
+        profiles.clear();
+        profiles.push_back({ "Default", settings_path, { }, axes, models });
+        active_profile_i = 0;
+        std::vector<std::filesystem::path> paths;
+        std::error_code ec;
+        for (const auto &entry : std::filesystem::directory_iterator(profiles_path, ec)) {
+            if (entry.path().extension() == ".json") paths.push_back(entry.path());
+        }
+        std::sort(paths.begin(), paths.end());
+        std::vector<std::vector<std::string>> targets;
+        for (const auto &path : paths) {
+            auto profile_res = load_profile(path);
+            if (!profile_res.has_value()) {
+                spdlog::error("Unable to load virtual pedal profile {}: {}", path.string(), profile_res.error());
+                continue;
+            }
+            spdlog::debug("Loaded virtual pedal profile \"{}\" for {} processes.", profile_res->name, profile_res->processes.size());
+            targets.push_back(profile_res->processes);
+            profiles.push_back(std::move(*profile_res));
+        }
+        if (games) games->set_targets(targets);
+    }
+
+    static void switch_profile(const size_t &profile_i) {
+        if (profile_i == active_profile_i || profile_i >= profiles.size()) return;
+        profiles[active_profile_i].axes = axes;
+        profiles[active_profile_i].models = models;
+        active_profile_i = profile_i;
+        axes = profiles[profile_i].axes;
+        models = profiles[profile_i].models;
+        if (working) publish_settings();
+        spdlog::info("Switched to virtual pedal profile \"{}\".", profiles[profile_i].name);
+    }
+
+    static std::shared_ptr<const compiled_settings> compile_settings(const pipeline_settings &settings) {
+        auto result = std::make_shared<compiled_settings>();
+        result->settings = settings;
+        for (int i = 0; i < settings.axes.size(); i++) {
+            const auto &axis = settings.axes[i];
+            pedals::transfer_settings transfer;
+            transfer.range_min = axis.output_steps_min / 1000.f;
+            transfer.range_max = axis.output_steps_max / 1000.f;
+            transfer.deadzone = axis.deadzone / 100.f;
+            transfer.limit = axis.output_limit / 100.f;
+            if (axis.curve_i >= 0 && axis.curve_i < settings.models.size()) {
+                const auto &model = settings.models[axis.curve_i];
+                transfer.curve_type = model.type;
+                for (int j = 0; j < model.num_points; j++) transfer.curve.push_back({
+                    static_cast<double>(model.points[j].x) / 100.0,
+                    static_cast<double>(model.points[j].y) / 100.0
+                });
+            }
+            result->batch.configure(i, transfer);
+        }
+        return result;
+    }
+
+    static void publish_settings() {
+        static std::optional<pipeline_settings> last_published;
+        pipeline_settings settings;
+        for (int i = 0; i < axes.size(); i++) {
+            settings.axes[i].output_steps_min = axes[i].output_steps_min;
+            settings.axes[i].output_steps_max = axes[i].output_steps_max;
+            settings.axes[i].deadzone = axes[i].deadzone;
+            settings.axes[i].output_limit = axes[i].output_limit;
+            settings.axes[i].curve_i = axes[i].curve_i;
+            settings.axes[i].filters = axes[i].filters;
+            settings.axes[i].auto_range = axes[i].auto_range;
+        }
+        for (int i = 0; i < models.size(); i++) {
+            settings.models[i].type = models[i].type;
+            settings.models[i].num_points = glm::min(models[i].points.size(), model::max_points);
+            settings.models[i].points.fill(glm::ivec2(0));
+            std::copy_n(models[i].points.begin(), settings.models[i].num_points, settings.models[i].points.begin());
+        }
+        if (last_published && memcmp(&*last_published, &settings, sizeof(settings)) == 0) return;
+        auto next = compile_settings(settings);
+        {
+            std::lock_guard guard(compiled_mutex);
+            compiled = std::move(next);
+            compiled_generation++;
+        }
+        last_published = settings;
+        spdlog::debug("Compiled virtual pedal transfer tables.");
+    }
+
+    static void apply_settings(const compiled_settings &next, pedals::pipeline &pipeline) {
+        pipeline.batch = next.batch;
+        for (int i = 0; i < next.settings.axes.size(); i++) {
+            const auto &axis = next.settings.axes[i];
+            if (pipeline.filters[i].configuration() != axis.filters) pipeline.filters[i].configure(axis.filters);
+            const auto ranging = axis.auto_range != auto_range_mode::off;
+            if (ranging && !pipeline.ranging[i]) pipeline.ranges[i].reset();
+            pipeline.ranging[i] = ranging;
+        }
+    }
+
+    static void publish_frame(const pedals::pipeline &pipeline, const pedals::frame &frame, snapshot &state) {
+        state.hardware_present = frame.present;
+        for (int j = 0; j < state.axes.size(); j++) {
+            const auto range = pipeline.ranges[j].current();
+            state.axes[j].range_ready = pipeline.ranging[j] && range.ready;
+            state.axes[j].range_min = range.min;
+            state.axes[j].range_max = range.max;
+            state.axes[j].present = j < frame.num_axes;
+            state.axes[j].input_raw = state.axes[j].present ? frame.inputs[j] : 0.f;
+            state.axes[j].input_steps = glm::round(state.axes[j].input_raw * 1000.f);
+            state.axes[j].output = frame.outputs[j];
+        }
+    }
+
+    static void work() {
+        timeBeginPeriod(1);
+        DEFER(timeEndPeriod(1));
+        snapshot state;
+        pedals::pipeline pipeline;
+        pedals::frame frame;
+        uint64_t applied_settings = 0, applied_generation = 0;
+        const pacer timer;
+        auto next_tick = pacer::clock::now();
+        auto rate_window_start = next_tick;
+        uint64_t rate_window_ticks = 0;
+        while (working) {
+            const auto now = pacer::clock::now();
+            if (const auto generation = compiled_generation.load(); generation != applied_settings) {
+                std::shared_ptr<const compiled_settings> next;
+                {
+                    std::lock_guard guard(compiled_mutex);
+                    next = compiled;
+                }
+                if (next) apply_settings(*next, pipeline);
+                applied_settings = generation;
+            }
+            if (const auto generation = calibration_generation.load(); generation != applied_generation) {
+                std::lock_guard guard(calibration_mutex);
+                pipeline.calibration = calibration;
+                applied_generation = generation;
+                calibration_applied = generation;
+            }
+            output->set_keep_alive(std::chrono::milliseconds(keep_alive_ms.load()));
+            if (const auto err = pipeline.tick(*source, *output, frame, &latency_stats); err) {
+                if (!report_failed.exchange(true)) spdlog::error(*err);
+            }
+            if (const auto axis_i = calibration_axis.load(std::memory_order_relaxed); axis_i >= 0 && axis_i < frame.num_axes && frame.fresh) calibration_recorder.record(frame.inputs[axis_i]);
+            publish_frame(pipeline, frame, state);
+            state.submissions_per_second = output->submissions_per_second();
+            state.num_submitted = output->num_submitted();
+            state.num_suppressed = output->num_suppressed();
+            state.num_ticks++;
+            rate_window_ticks++;
+            if (const auto elapsed = now - rate_window_start; elapsed >= std::chrono::seconds(1)) {
+                state.rate_hz = rate_window_ticks / std::chrono::duration<float>(elapsed).count();
+                rate_window_start = now;
+                rate_window_ticks = 0;
+            }
+            published_state.store(state);
+            next_tick += std::chrono::nanoseconds(1000000000 / glm::max(1, rate_hz.load()));
+            if (const auto after = pacer::clock::now(); next_tick < after) next_tick = after;
+            else timer.wait_until(next_tick);
+        }
+    }
+
+    static std::optional<std::string> publish_calibration(const std::shared_ptr<const pedals::calibration_set> &updated) {
+        uint64_t generation;
+        {
+            std::lock_guard guard(calibration_mutex);
+            calibration = updated;
+            generation = ++calibration_generation;
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(250);
+        while (working && calibration_applied != generation) {
+            if (std::chrono::steady_clock::now() >= deadline) return "Virtual pedal pipeline did not pick up the new calibration.";
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return std::nullopt;
+    }
+
+    static std::optional<std::string> update_calibration(const int &axis_i, const std::optional<pedals::calibration_table> &table) {
+        if (axis_i < 0 || axis_i >= pedals::axis_batch::lanes) return "Invalid axis.";
+        std::shared_ptr<pedals::calibration_set> updated;
+        {
+            std::lock_guard guard(calibration_mutex);
+            updated = calibration ? std::make_shared<pedals::calibration_set>(*calibration) : std::make_shared<pedals::calibration_set>();
+        }
+        updated->present[axis_i] = table.has_value();
+        updated->tables[axis_i] = table.value_or(pedals::calibration_table::identity());
+        if (const auto err = publish_calibration(updated); err) return err;
+        return pedals::calibration_set::save(calibration_path, *updated);
+    }
+
+    static void startup() {
+        publish_settings();
+        published_state.store(snapshot());
+        latency_stats.reset();
+        working = true;
+        worker = std::thread(work);
+        spdlog::debug("Started virtual pedal pipeline at {} Hz.", rate_hz.load());
+    }
+
+    static void shutdown() {
+        working = false;
+        if (worker.joinable()) {
+            worker.join();
+            spdlog::debug("Stopped virtual pedal pipeline.");
+        }
+        published_state.store(snapshot());
+    }
 }
 
 std::optional<std::string> sc::visor::legacy::enable() {
@@ -99,107 +523,67 @@ std::optional<std::string> sc::visor::legacy::enable() {
     if (!hidhide::is_enabled() && !hidhide::set_enabled(true)) return "Unable to activate HIDHIDE.";
     if (const auto err = sync_blacklist(); err) return err;
     if (const auto err = whitelist_this_module(); err) return err;
-    if (auto new_vigem_client = vigem_alloc(); new_vigem_client) {
-        if (VIGEM_SUCCESS(vigem_connect(new_vigem_client))) {
-            if (auto new_vigem_gamepad = vigem_target_ds4_alloc(); new_vigem_gamepad) {
-                vigem_target_set_pid(new_vigem_gamepad, 0x1209);
-                vigem_target_set_vid(new_vigem_gamepad, 0x0070);
-                if (VIGEM_SUCCESS(vigem_target_add(new_vigem_client, new_vigem_gamepad))) {
-                    vigem_client = new_vigem_client;
-                    vigem_gamepad = new_vigem_gamepad;
-                    spdlog::debug("Legacy support enabled.");
-                    if (const auto err = load_settings(); err) spdlog::error("Unable to load legacy settings: {}", *err);
-                    else spdlog::debug("Loaded legacy settings");
-                    return std::nullopt;
-                } else {
-                    vigem_target_free(new_vigem_gamepad);
-                    vigem_disconnect(new_vigem_client);
-                    vigem_free(new_vigem_client);
-                    return "Unable to activate ViGEmBus gamepad.";
-                }
-            } else {
-                vigem_disconnect(new_vigem_client);
-                vigem_free(new_vigem_client);
-                return "Unable to allocate required memory for ViGEmBus gamepad target.";
-            }
-        } else {
-            vigem_free(new_vigem_client);
-            return "Unable to connect to ViGEmBus driver.";
-        }
-    } else return "Unable to allocate required memory for ViGEmBus driver connection.";
+    auto new_source = input::create_winmm("Sim Coaches P1 Pro Pedals");
+    if (!new_source.has_value()) return new_source.error();
+    auto new_output = sink::create_vigem_ds4(0x0070, 0x1209);
+    if (!new_output.has_value()) return new_output.error();
+    source = std::move(*new_source);
+    source->set_connection_callback([](const bool &connected) {
+        if (connected) spdlog::debug("Found legacy hardware.");
+        else spdlog::debug("Lost legacy hardware.");
+    });
+    output = std::make_unique<sink::change_gate>(std::move(*new_output), std::chrono::milliseconds(keep_alive_ms.load()));
+    spdlog::debug("Legacy support enabled.");
+    games = std::make_unique<process::monitor>(process::create_system_watcher());
+    if (const auto err = load_settings(); err) spdlog::error("Unable to load legacy settings: {}", *err);
+    else spdlog::debug("Loaded legacy settings");
+    games_generation.reset();
+    games->start();
+    if (auto calibration_res = pedals::calibration_set::load(calibration_path); calibration_res.has_value()) {
+        publish_calibration(*calibration_res);
+        spdlog::debug("Mapped virtual pedal calibration.");
+    } else spdlog::debug("No virtual pedal calibration: {}", calibration_res.error());
+    startup();
+    return std::nullopt;
 }
 
 void sc::visor::legacy::disable() {
-    if (vigem_gamepad) {
-        if (vigem_client) vigem_target_remove(*vigem_client, *vigem_gamepad);
-        vigem_target_free(*vigem_gamepad);
-        vigem_gamepad.reset();
-        spdlog::debug("Disconnected gamepad from ViGEmBus driver.");
-    }
-    if (vigem_client) {
-        vigem_disconnect(*vigem_client);
-        vigem_free(*vigem_client);
-        vigem_client.reset();
-        spdlog::debug("Disconnected from ViGEmBus driver.");
+    games.reset();
+    shutdown();
+    cancel_calibration();
+    publish_calibration(nullptr);
+    if (output) {
+        spdlog::debug("Released {} output.", output->name());
+        output.reset();
     }
-    vigem_gamepad_report.reset();
+    source.reset();
     spdlog::debug("Legacy support disabled.");
 }
 
-std::optional<std::string> sc::visor::legacy::process() {
-    for (auto &axis : axes) {
-        axis.present = false;
-        axis.input_raw = 0.f;
+std::optional<std::string> sc::visor::legacy::sync() {
+    if (const auto generation = games ? games->generation() : 0; games && generation != games_generation) {
+        const auto game_i = games->active();
+        switch_profile(game_i ? *game_i + 1 : 0);
+        games_generation = generation;
     }
-    if (!vigem_client || !vigem_gamepad) return std::nullopt;
-    if (!vigem_gamepad_report) {
-        vigem_gamepad_report = DS4_REPORT();
-        DS4_REPORT_INIT(&*vigem_gamepad_report);
-        vigem_gamepad_report->bThumbLX = 128;
-        vigem_gamepad_report->bThumbLY = 128;
-        vigem_gamepad_report->bThumbRX = 128;
-        vigem_gamepad_report->bThumbRY = 128;
-        vigem_gamepad_report->bTriggerL = 128;
-        vigem_gamepad_report->bTriggerR = 128;
-        spdlog::debug("Initialized gamepad USB report structure.");
-    }
-    found_legacy_hardware = false;
-    for (int i = 0; i < GLFW_JOYSTICK_LAST; i++) {
-        if (!glfwJoystickPresent(i)) continue;
-        if (strcmp("Sim Coaches P1 Pro Pedals", glfwGetJoystickName(i)) != 0) continue;
-        int num_axes;
-        const auto inputs = glfwGetJoystickAxes(i, &num_axes);
-        if (!inputs) continue;
-        for (int j = 0; j < glm::min(num_axes, static_cast<int>(axes.size())); j++) {
-            axes[j].present = true;
-            float value = glm::max(0.f, glm::min(1.f, (inputs[j] + 1.f) * .5f));
-            axes[j].input_raw = value;
-            axes[j].input_steps = glm::round(value * 1000.f);
-            auto max_input = axes[j].output_steps_max / 1000.f;
-            auto min_input = (axes[j].output_steps_min + ((axes[j].output_steps_max - axes[j].output_steps_min) * (axes[j].deadzone / 100.f))) / 1000.f;
-            if (min_input > max_input) min_input = max_input;
-            value -= min_input;
-            value *= 1.f / (max_input - min_input);
-            value = glm::min(1.f, glm::max(0.f, value));
-            if (axes[j].curve_i >= 0) {
-                std::vector<glm::dvec2> model;
-                for (auto &percent : legacy::models[axes[j].curve_i].points) model.push_back({
-                    static_cast<double>(percent.x) / 100.0,
-                    static_cast<double>(percent.y) / 100.0
-                });
-                value = bezier::calculate(model, value).y;
-            }
-            value = glm::min(value, axes[j].output_limit / 100.f);
-            if (j == 0) vigem_gamepad_report->bThumbLX = 127 + glm::round(128 * value);
-            else if (j == 1) vigem_gamepad_report->bThumbLY = 127 + glm::round(128 * value);
-            else if (j == 2) vigem_gamepad_report->bThumbRX = 127 + glm::round(128 * value);
-            else if (j == 3) vigem_gamepad_report->bThumbRY = 127 + glm::round(128 * value);
-            axes[j].output = value;
+    if (working) publish_settings();
+    const auto state = published_state.load();
+    for (int i = 0; i < axes.size(); i++) {
+        axes[i].present = state.axes[i].present;
+        axes[i].input_raw = state.axes[i].input_raw;
+        axes[i].input_steps = state.axes[i].input_steps;
+        axes[i].output = state.axes[i].output;
+        if (state.axes[i].range_ready) axes[i].proposed_range = glm::ivec2 { glm::round(state.axes[i].range_min * 1000.f), glm::round(state.axes[i].range_max * 1000.f) };
+        else axes[i].proposed_range.reset();
+        if (axes[i].auto_range != auto_range_mode::apply || !axes[i].proposed_range) continue;
+        if (glm::abs(axes[i].proposed_range->x - axes[i].output_steps_min) >= auto_range_hysteresis || glm::abs(axes[i].proposed_range->y - axes[i].output_steps_max) >= auto_range_hysteresis) {
+            axes[i].output_steps_min = axes[i].proposed_range->x;
+            axes[i].output_steps_max = axes[i].proposed_range->y;
+            spdlog::debug("Auto range updated virtual axis #{}: {}, {}", i + 1, axes[i].output_steps_min, axes[i].output_steps_max);
         }
-        found_legacy_hardware = true;
-        break;
     }
-    vigem_target_ds4_update(*vigem_client, *vigem_gamepad, *vigem_gamepad_report);
+    found_legacy_hardware = state.hardware_present;
+    if (output && report_failed.exchange(false)) return fmt::format("Unable to submit gamepad report to {}.", output->name());
     return std::nullopt;
 }
 
@@ -207,72 +591,111 @@ bool sc::visor::legacy::present() {
     return found_legacy_hardware;
 }
 
+sc::visor::legacy::snapshot sc::visor::legacy::latest() {
+    return published_state.load();
+}
+
+void sc::visor::legacy::begin_calibration(const int &axis_i) {
+    calibration_axis = -1;
+    calibration_recorder.reset();
+    calibration_axis = axis_i;
+    spdlog::info("Recording calibration sweep for virtual axis #{}.", axis_i + 1);
+}
+
+void sc::visor::legacy::cancel_calibration() {
+    calibration_axis = -1;
+}
+
+std::optional<int> sc::visor::legacy::calibrating_axis() {
+    if (const auto axis_i = calibration_axis.load(); axis_i >= 0) return axis_i;
+    return std::nullopt;
+}
+
+uint64_t sc::visor::legacy::calibration_samples() {
+    return calibration_recorder.num_samples();
+}
+
+bool sc::visor::legacy::calibrated(const int &axis_i) {
+    std::lock_guard guard(calibration_mutex);
+    return calibration && axis_i >= 0 && axis_i < calibration->present.size() && calibration->present[axis_i];
+}
+
+std::optional<std::string> sc::visor::legacy::finish_calibration() {
+    const auto axis_i = calibration_axis.exchange(-1);
+    if (axis_i < 0) return "No calibration sweep is being recorded.";
+    const auto table_res = calibration_recorder.build();
+    if (!table_res.has_value()) return table_res.error();
+    if (const auto err = update_calibration(axis_i, *table_res); err) return err;
+    spdlog::info("Calibrated virtual axis #{} from {} samples.", axis_i + 1, calibration_recorder.num_samples());
+    return std::nullopt;
+}
+
+std::optional<std::string> sc::visor::legacy::clear_calibration(const int &axis_i) {
+    return update_calibration(axis_i, std::nullopt);
+}
+
+const sc::pedals::latency_stats &sc::visor::legacy::latency() {
+    return latency_stats;
+}
+
+int sc::visor::legacy::get_rate() {
+    return rate_hz;
+}
+
+void sc::visor::legacy::set_rate(const int &hz) {
+    rate_hz = glm::clamp(hz, 1, 8000);
+}
+
+int sc::visor::legacy::get_keep_alive() {
+    return keep_alive_ms;
+}
+
+void sc::visor::legacy::set_keep_alive(const int &milliseconds) {
+    keep_alive_ms = glm::clamp(milliseconds, 1, 10000);
+}
+
 std::optional<std::string> sc::visor::legacy::save_settings() {
-    nlohmann::json doc, axes_doc;
-    for (int i = 0; i < axes.size(); i++) {
-        nlohmann::json axis_doc;
-        axis_doc["min"] = axes[i].output_steps_min;
-        axis_doc["max"] = axes[i].output_steps_max;
-        axis_doc["deadzone"] = axes[i].deadzone;
-        axis_doc["limit"] = axes[i].output_limit;
-        if (axes[i].curve_i != -1) axis_doc["curve"] = axes[i].curve_i;
-        if (axes[i].label) axis_doc["label"] = axes[i].label->data();
-        axes_doc.push_back(axis_doc);
+    if (active_profile_i >= profiles.size()) return "No virtual pedal profile is loaded.";
+    auto &active = profiles[active_profile_i];
+    auto doc = profile_to_json(axes, models);
+    if (active_profile_i == 0) {
+        doc["rate"] = rate_hz.load();
+        doc["keep_alive"] = keep_alive_ms.load();
+    } else {
+        doc["name"] = active.name;
+        doc["processes"] = active.processes;
     }
-    doc["axes"] = axes_doc;
-    nlohmann::json models_doc;
-    for (int i = 0; i < models.size(); i++) {
-        nlohmann::json model_doc;
-        if (models[i].label) model_doc["label"] = *models[i].label;
-        nlohmann::json points_doc;
-        for (int j = 0; j < models[i].points.size(); j++) {
-            nlohmann::json point_doc = {
-                { "x", models[i].points[j].x },
-                { "y", models[i].points[j].y }
-            };
-            points_doc.push_back(point_doc);
-        }
-        model_doc["points"] = points_doc;
-        models_doc.push_back(model_doc);
-    }
-    doc["models"] = models_doc;
     auto doc_content = doc.dump(4);
     std::vector<std::byte> doc_data;
     doc_data.resize(doc_content.size());
     memcpy(doc_data.data(), doc_content.data(), glm::min(doc_data.size(), doc_content.size()));
-    if (const auto err = file::save("virtual-pedals.json", doc_data); err) return *err;
+    if (const auto err = file::save(active.path, doc_data); err) return *err;
+    active.axes = axes;
+    active.models = models;
     return std::nullopt;
 }
 
 std::optional<std::string> sc::visor::legacy::load_settings() {
-    const auto load_res = file::load("virtual-pedals.json");
+    DEFER(load_profiles());
+    const auto load_res = file::load(settings_path);
     if (!load_res.has_value()) return load_res.error();
     auto doc = nlohmann::json::parse(*load_res);
-    if (auto axes_doc = doc.find("axes"); axes_doc != doc.end() && axes_doc->is_array()) {
-        for (int i = 0; i < glm::min(axes_doc->size(), axes.size()); i++) {
-            axes[i].output_steps_min = axes_doc->at(i).value("min", 0);
-            axes[i].output_steps_max = axes_doc->at(i).value("max", 100);
-            axes[i].deadzone = axes_doc->at(i).value("deadzone", 0);
-            axes[i].output_limit = axes_doc->at(i).value("limit", 100);
-            axes[i].curve_i = axes_doc->at(i).value("curve", -1);
-            axes[i].model_edit_i = axes[i].curve_i;
-            if (axes_doc->at(i).find("label") != axes_doc->at(i).end()) axes[i].label = axes_doc->at(i)["label"];
-        }
-    }
-    if (auto models_doc = doc.find("models"); models_doc != doc.end() && models_doc->is_array()) {
-        for (int i = 0; i < glm::min(models_doc->size(), models.size()); i++) {
-            auto model_doc = models_doc->at(i);
-            if (auto label = model_doc.find("label"); label != model_doc.end() && label->is_string()) {
-                models[i].label = *label;
-                strcpy_s(models[i].label_buffer.data(), models[i].label_buffer.size(), models[i].label->data());
-            }
-            if (auto points_doc = model_doc.find("points"); points_doc->is_array()) {
-                for (int j = 0; j < points_doc->size(); j++) {
-                    models[i].points[j].x = points_doc->at(j).value("x", 0);
-                    models[i].points[j].y = points_doc->at(j).value("y", 0);
-                }
-            }
-        }
-    }
+    profile_from_json(doc, axes, models);
+    set_rate(doc.value("rate", 1000));
+    set_keep_alive(doc.value("keep_alive", 250));
     return std::nullopt;
 }
+
+std::vector<std::string> sc::visor::legacy::profile_names() {
+    std::vector<std::string> names;
+    for (const auto &profile : profiles) names.push_back(profile.name);
+    return names;
+}
+
+size_t sc::visor::legacy::active_profile() {
+    return active_profile_i;
+}
+
+void sc::visor::legacy::activate_profile(const size_t &profile_i) {
+    switch_profile(profile_i);
+}
@@ -5,11 +5,21 @@
 #include <optional>
 #include <cstdint>
 #include <limits>
+#include <vector>
 
 #include <glm/vec2.hpp>
 
+#include "../../libs/pedals/pipeline.h"
+
 namespace sc::visor::legacy {
 
+    enum class auto_range_mode {
+
+        off,
+        propose,
+        apply
+    };
+
     struct axis_info {
 
         bool present = false;
@@ -22,13 +32,19 @@ namespace sc::visor::legacy {
         int output_limit = 100;
         int model_edit_i = -1;
         int curve_i = -1;
+        pedals::filter_chain::settings filters;
+        auto_range_mode auto_range = auto_range_mode::off;
+        std::optional<glm::ivec2> proposed_range;
         std::optional<std::string> label;
         std::array<char, 50> label_buffer;
     };
 
     struct model {
 
-        std::array<glm::ivec2, 6> points = {
+        static constexpr size_t max_points = 16;
+
+        pedals::curve_kind type = pedals::curve_kind::bezier;
+        std::vector<glm::ivec2> points = {
             glm::ivec2 { 0, 0 },
             glm::ivec2 { 20, 20 },
             glm::ivec2 { 40, 40 },
@@ -41,6 +57,26 @@ namespace sc::visor::legacy {
         std::array<char, 50> label_buffer = { 0 };
     };
 
+    struct axis_state {
+
+        bool present = false;
+        float input_raw = 0;
+        int input_steps = 0;
+        float output = 0;
+        bool range_ready = false;
+        float range_min = 0, range_max = 1;
+    };
+
+    struct snapshot {
+
+        bool hardware_present = false;
+        float rate_hz = 0;
+        float submissions_per_second = 0;
+        uint64_t num_ticks = 0;
+        uint64_t num_submitted = 0, num_suppressed = 0;
+        std::array<axis_state, 4> axes;
+    };
+
     extern std::array<axis_info, 4> axes;
     extern std::array<model, 5> models;
 
@@ -50,8 +86,27 @@ namespace sc::visor::legacy {
 
     std::optional<std::string> enable();
     void disable();
-    std::optional<std::string> process();
+    std::optional<std::string> sync();
     bool present();
+    snapshot latest();
+    const pedals::latency_stats &latency();
+
+    void begin_calibration(const int &axis_i);
+    void cancel_calibration();
+    std::optional<std::string> finish_calibration();
+    std::optional<std::string> clear_calibration(const int &axis_i);
+    std::optional<int> calibrating_axis();
+    uint64_t calibration_samples();
+    bool calibrated(const int &axis_i);
+
+    int get_rate();
+    void set_rate(const int &hz);
+    int get_keep_alive();
+    void set_keep_alive(const int &milliseconds);
+
+    std::vector<std::string> profile_names();
+    size_t active_profile();
+    void activate_profile(const size_t &profile_i);
 
     std::optional<std::string> load_settings();
     std::optional<std::string> save_settings();
@@ -7,6 +7,7 @@
 #define SC_FEATURE_RENDER_ON_RESIZE
 #define SC_FEATURE_SYSTEM_TRAY
 #define SC_FEATURE_CENTER_WINDOW
+#define SC_FEATURE_HEADLESS
 
 #define SC_VIEW_INIT_W 728
 #define SC_VIEW_INIT_H 636
@@ -16,19 +17,37 @@
 #include "../../libs/boot/imgui_gl3_glfw3.hpp"
 #include "../../libs/iracing/iracing.h"
 
-#include "legacy.h"
+#include "service.h"
 
 static bool enforce_one_instance() {
+    static bool is_only_instance = false;
+    if (is_only_instance) return true;
     const auto mutex = CreateMutex(NULL, TRUE, "SimCoachesVisorEcosystemApplication");
     if (auto mutex_wait_res = WaitForSingleObject(mutex, 0); mutex_wait_res != WAIT_OBJECT_0) {
         MessageBox(NULL, "It seems like Visor is already running. Look for the icon on your taskbar.", "Visor", MB_OK | MB_ICONINFORMATION);
         return false; 
-    } else return true;
+    } else return is_only_instance = true;
+}
+
+static std::optional<std::string> sc::boot::on_headless_startup() {
+    if (!enforce_one_instance()) return "Duplicate instance.";
+    visor::service::startup();
+    return std::nullopt;
+}
+
+static tl::expected<bool, std::string> sc::boot::on_headless_update() {
+    visor::service::update();
+    return visor::keep_running;
+}
+
+static void sc::boot::on_headless_shutdown() {
+    visor::service::shutdown();
 }
 
 static std::optional<std::string> sc::boot::on_startup() {
     if (!enforce_one_instance()) return "Duplicate instance.";
     // iracing::startup();
+    visor::service::startup();
     visor::gui::initialize();
     return std::nullopt;
 }
@@ -39,15 +58,12 @@ static tl::expected<bool, std::string> sc::boot::on_fixed_update() {
 
 static tl::expected<bool, std::string> sc::boot::on_update(const glm::ivec2 &framebuffer_size, bool *const force_redraw) {
     visor::gui::emit(framebuffer_size, force_redraw);
-    if (const auto err = visor::legacy::process(); err) {
-        sc::visor::legacy_support_error = true;
-        sc::visor::legacy_support_error_description = *err;
-    }
+    visor::service::update();
     return visor::keep_running;
 }
 
 static void sc::boot::on_shutdown() {
     visor::gui::shutdown();
     // iracing::shutdown();
-    visor::legacy::disable();
+    visor::service::shutdown();
 }
\ No newline at end of file
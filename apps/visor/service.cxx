@@ -0,0 +1,89 @@
+#include "service.h"
+#include "application.h"
+#include "device_actor.h"
+#include "aggregator.h"
+#include "legacy.h"
+
+#include <spdlog/spdlog.h>
+
+namespace sc::visor::service {
+
+    static bool started = false;
+    static bool enable_legacy_support = false;
+    static std::vector<std::shared_ptr<device_context>> device_contexts;
+
+    static void poll_devices() {
+        while (const auto event = device_supervisor::next_event()) {
+            switch (event->type) {
+                case device_event::kind::attached:
+                    device_contexts.push_back(event->context);
+                    aggregator::attach(event->context);
+                    break;
+                case device_event::kind::ready:
+                    spdlog::info("Device ready: {}", event->context->serial);
+                    break;
+                case device_event::kind::command_failed:
+                    if (event->error) spdlog::warn("Device command failed ({}): {}", event->context->serial, *event->error);
+                    break;
+                case device_event::kind::lost:
+                    if (event->error) spdlog::error("Device context error: {}", *event->error);
+                    break;
+            }
+        }
+    }
+}
+
+void sc::visor::service::startup() {
+    if (started) return;
+    if (const auto err = aggregator::load_settings(); err) spdlog::debug("Unable to load combined device settings: {}", *err);
+    aggregator::startup();
+    device_supervisor::startup();
+    started = true;
+    if (legacy_is_default) toggle_legacy();
+    spdlog::debug("Started device services.");
+}
+
+void sc::visor::service::shutdown() {
+    if (!started) return;
+    if (enable_legacy_support) {
+        legacy::disable();
+        enable_legacy_support = false;
+    }
+    device_supervisor::shutdown();
+    aggregator::shutdown();
+    aggregator::detach_all();
+    device_contexts.clear();
+    started = false;
+    spdlog::debug("Stopped device services.");
+}
+
+bool sc::visor::service::running() {
+    return started;
+}
+
+void sc::visor::service::update() {
+    poll_devices();
+    if (const auto err = legacy::sync(); err) {
+        legacy_support_error = true;
+        legacy_support_error_description = *err;
+    }
+}
+
+const std::vector<std::shared_ptr<sc::visor::device_context>> &sc::visor::service::devices() {
+    return device_contexts;
+}
+
+bool sc::visor::service::legacy_enabled() {
+    return enable_legacy_support;
+}
+
+void sc::visor::service::toggle_legacy() {
+    if (enable_legacy_support) {
+        legacy::disable();
+        enable_legacy_support = false;
+    } else if (const auto err = legacy::enable(); err) {
+        spdlog::error("Unable to enable legacy support: {}", *err);
+        legacy_support_error = true;
+        legacy_support_error_description = *err;
+    } else enable_legacy_support = true;
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "device_context.h"
+
+#include <memory>
+#include <vector>
+
+namespace sc::visor::service {
+
+    static constexpr bool legacy_is_default = true;
+
+    void startup();
+    void shutdown();
+    bool running();
+    void update();
+
+    const std::vector<std::shared_ptr<device_context>> &devices();
+
+    bool legacy_enabled();
+    void toggle_legacy();
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <spdlog/spdlog.h>
+
+#include "../../libs/firmware/emulator.h"
+
+#include "device_actor.h"
+
+#include <chrono>
+#include <functional>
+#include <thread>
+
+namespace sl = spdlog;
+
+static bool wait_for(const std::function<bool()> &condition, const std::chrono::milliseconds &timeout = std::chrono::seconds(2)) {
+    const auto deadline = std::chrono::high_resolution_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::high_resolution_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static std::optional<sc::visor::device_event> wait_for_event(sc::visor::device_event_queue &events) {
+    std::optional<sc::visor::device_event> event;
+    wait_for([&]() {
+        event = events.try_pop();
+        return event.has_value();
+    });
+    return event;
+}
+
+int main() {
+    sl::default_logger()->set_level(sl::level::debug);
+    auto device = std::make_shared<sc::firmware::mk4::emulator>(3);
+    const auto handle = sc::firmware::mk4::emulator::open(device, "0001");
+    if (!handle.has_value()) {
+        sl::error("Unable to open emulated device: {}", handle.error());
+        return 1;
+    }
+    sc::visor::device_event_queue events;
+    auto context = std::make_shared<sc::visor::device_context>();
+    context->name = (*handle)->name;
+    context->serial = (*handle)->serial;
+    sc::visor::device_actor actor(*handle, context, events);
+    device->set_input(1, 32768);
+    actor.start();
+    if (const auto event = wait_for_event(events); !event || event->type != sc::visor::device_event::kind::ready) {
+        sl::error("Expected a ready event.");
+        return 1;
+    }
+    {
+        SC_LOCK_GUARD(context->mutex);
+        if (context->axes.size() != 3 || context->axes[1].input != 32768 || context->version_major != 4) {
+            sl::error("Handshake did not populate the device context.");
+            return 1;
+        }
+    }
+    device->set_input(1, 1000);
+    if (!wait_for([&]() {
+        SC_LOCK_GUARD(context->mutex);
+        return context->axes[1].input == 1000;
+    })) {
+        sl::error("Axis state was not polled.");
+        return 1;
+    }
+    if (!context->post(sc::visor::device_command::axis_range(0, 100, 60000, 5, 90)) || !context->post(sc::visor::device_command::save())) {
+        sl::error("Unable to post commands.");
+        return 1;
+    }
+    if (!wait_for([&]() {
+        std::lock_guard guard(device->mutex);
+        return device->num_commits == 1 && device->axes[0].min == 100 && device->axes[0].max == 60000 && device->axes[0].deadzone == 5 && device->axes[0].limit == 90;
+    })) {
+        sl::error("Commands were not applied to the device.");
+        return 1;
+    }
+    device->unplug();
+    if (const auto event = wait_for_event(events); !event || event->type != sc::visor::device_event::kind::lost) {
+        sl::error("Expected a lost event.");
+        return 1;
+    }
+    if (!wait_for([&]() { return !actor.running(); }) || context->connected || context->post(sc::visor::device_command::save())) {
+        sl::error("Actor did not wind down after the device was lost.");
+        return 1;
+    }
+    auto crowded_device = std::make_shared<sc::firmware::mk4::emulator>(3);
+    const auto crowded_handle = sc::firmware::mk4::emulator::open(crowded_device, "0002");
+    if (!crowded_handle.has_value()) {
+        sl::error("Unable to open emulated device: {}", crowded_handle.error());
+        return 1;
+    }
+    auto crowded_context = std::make_shared<sc::visor::device_context>();
+    crowded_context->serial = (*crowded_handle)->serial;
+    sc::visor::device_actor crowded_actor(*crowded_handle, crowded_context, events);
+    crowded_actor.start();
+    if (const auto event = wait_for_event(events); !event || event->type != sc::visor::device_event::kind::ready) {
+        sl::error("Expected a ready event.");
+        return 1;
+    }
+    while (events.try_push(sc::visor::device_event { sc::visor::device_event::kind::command_failed, crowded_context }));
+    crowded_device->unplug();
+    if (!wait_for([&]() { return !crowded_actor.running(); }) || !crowded_context->lost_pending) {
+        sl::error("Lost event was dropped instead of deferred when the event queue was full.");
+        return 1;
+    }
+    auto unannounced_device = std::make_shared<sc::firmware::mk4::emulator>(3);
+    const auto unannounced_handle = sc::firmware::mk4::emulator::open(unannounced_device, "0003");
+    if (!unannounced_handle.has_value()) {
+        sl::error("Unable to open emulated device: {}", unannounced_handle.error());
+        return 1;
+    }
+    auto unannounced_context = std::make_shared<sc::visor::device_context>();
+    unannounced_context->serial = (*unannounced_handle)->serial;
+    sc::visor::announce(events, unannounced_context);
+    if (!unannounced_context->attached_pending) {
+        sl::error("Attached event was dropped instead of deferred when the event queue was full.");
+        return 1;
+    }
+    sc::visor::device_actor unannounced_actor(*unannounced_handle, unannounced_context, events);
+    unannounced_actor.start();
+    if (!wait_for([&]() { return unannounced_context->initial_communication_complete.load(); })) {
+        sl::error("Handshake did not complete for the unannounced device.");
+        return 1;
+    }
+    while (events.try_pop());
+    unannounced_device->unplug();
+    if (!wait_for([&]() { return !unannounced_actor.running(); }) || !unannounced_context->lost_pending || events.try_pop()) {
+        sl::error("Actor emitted events before its device was announced.");
+        return 1;
+    }
+    sc::visor::flush_deferred(events, { unannounced_context });
+    const auto attached = events.try_pop();
+    const auto lost = events.try_pop();
+    if (!attached || attached->type != sc::visor::device_event::kind::attached || attached->context != unannounced_context || !lost || lost->type != sc::visor::device_event::kind::lost || lost->context != unannounced_context) {
+        sl::error("Deferred attached and lost events were not delivered in order.");
+        return 1;
+    }
+    if (unannounced_context->attached_pending || unannounced_context->lost_pending) {
+        sl::error("Deferred events stayed pending after they were delivered.");
+        return 1;
+    }
+    sl::info("Device actor test passed.");
+    return 0;
+}
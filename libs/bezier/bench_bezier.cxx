@@ -0,0 +1,67 @@
+#include <spdlog/spdlog.h>
+
+#include "bezier.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <glm/common.hpp>
+
+namespace sl = spdlog;
+
+static glm::dvec2 calculate_by_value(std::vector<glm::dvec2> inputs, double power, std::optional<std::function<void(const std::vector<glm::dvec2> &level)>> callback = std::nullopt) {
+    for (;;) {
+        for (size_t i = 0; i < inputs.size() - 1; i++) inputs[i] = glm::mix(inputs[i], inputs[i + 1], power);
+        inputs.resize(inputs.size() - 1);
+        if (inputs.size() == 1) return inputs.front();
+        if (callback) (*callback)(inputs);
+    }
+}
+
+template<typename F>
+static double measure(const size_t &num_samples, F &&callback) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    callback();
+    const auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    return static_cast<double>(num_samples) / elapsed;
+}
+
+int main() {
+    constexpr size_t num_samples = 1 << 20;
+    constexpr std::array<glm::dvec2, 6> points = { glm::dvec2 { 0, 0 }, { .2, .1 }, { .4, .3 }, { .6, .55 }, { .8, .8 }, { 1, 1 } };
+    static_assert(sc::bezier::calculate(std::array<glm::dvec2, 2> { glm::dvec2 { 0, 0 }, { 1, 1 } }, .5).x == .5, "the fixed degree kernel is usable in constant expressions");
+    const std::vector<glm::dvec2> vector_points(points.begin(), points.end());
+    std::vector<double> powers(num_samples);
+    std::vector<glm::dvec2> by_value(num_samples), dispatched(num_samples), fixed(num_samples), batch(num_samples);
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    for (auto &power : powers) power = distribution(generator);
+    const auto by_value_rate = measure(num_samples, [&]() {
+        for (size_t i = 0; i < num_samples; i++) by_value[i] = calculate_by_value(vector_points, powers[i]);
+    });
+    const auto dispatched_rate = measure(num_samples, [&]() {
+        for (size_t i = 0; i < num_samples; i++) dispatched[i] = sc::bezier::calculate(vector_points, powers[i]);
+    });
+    const auto fixed_rate = measure(num_samples, [&]() {
+        for (size_t i = 0; i < num_samples; i++) fixed[i] = sc::bezier::calculate(points, powers[i]);
+    });
+    const auto batch_rate = measure(num_samples, [&]() {
+        sc::bezier::calculate(points, powers.data(), batch.data(), num_samples);
+    });
+    double max_error = 0;
+    for (size_t i = 0; i < num_samples; i++) {
+        max_error = glm::max(max_error, glm::max(glm::abs(by_value[i].x - fixed[i].x), glm::abs(by_value[i].y - fixed[i].y)));
+        if (memcmp(&fixed[i], &batch[i], sizeof(glm::dvec2)) != 0 || memcmp(&fixed[i], &dispatched[i], sizeof(glm::dvec2)) != 0) {
+            sl::error("Fixed degree paths disagree at sample #{}.", i);
+            return 1;
+        }
+    }
+    sl::info("std::vector by value: {:.2f}M evaluations/sec", by_value_rate / 1e6);
+    sl::info("std::vector dispatched: {:.2f}M evaluations/sec", dispatched_rate / 1e6);
+    sl::info("std::array<6>: {:.2f}M evaluations/sec", fixed_rate / 1e6);
+    sl::info("std::array<6> batch: {:.2f}M evaluations/sec", batch_rate / 1e6);
+    sl::info("Max difference to the by value path: {:.2e}", max_error);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "bezier.h"
+
+#include <glm/common.hpp>
+
+namespace sc::bezier {
+
+    template<size_t N>
+    static glm::dvec2 calculate_fixed(const std::vector<glm::dvec2> &inputs, const double &power) {
+        std::array<glm::dvec2, N> points;
+        std::copy_n(inputs.begin(), N, points.begin());
+        return calculate(points, power);
+    }
+
+    static double derivative_x(const std::vector<glm::dvec2> &inputs, const double &power) {
+        if (inputs.size() < 2) return 0;
+        std::vector<glm::dvec2> differences(inputs.size() - 1);
+        for (size_t i = 0; i < differences.size(); i++) differences[i] = inputs[i + 1] - inputs[i];
+        const auto slope = calculate(differences, power);
+        return static_cast<double>(differences.size()) * slope.x;
+    }
+
+    static double solve_power(const std::vector<glm::dvec2> &inputs, const double &x) {
+        if (x <= inputs.front().x) return 0;
+        if (x >= inputs.back().x) return 1;
+        double low = 0, high = 1;
+        auto power = glm::clamp((x - inputs.front().x) / (inputs.back().x - inputs.front().x), 0.0, 1.0);
+        for (int i = 0; i < 64; i++) {
+            const auto error = calculate(inputs, power).x - x;
+            if (glm::abs(error) < 1e-12) break;
+            if (error < 0) low = power;
+            else high = power;
+            const auto slope = derivative_x(inputs, power);
+            auto next = slope > 1e-9 ? power - error / slope : low - 1;
+            if (next <= low || next >= high) next = (low + high) * .5;
+            if (high - low < 1e-15) break;
+            power = next;
+        }
+        return power;
+    }
+}
+
+glm::dvec2 sc::bezier::calculate(const std::vector<glm::dvec2> &inputs, double power, std::optional<std::function<void(const std::vector<glm::dvec2> &level)>> callback) {
+    if (!callback) {
+        switch (inputs.size()) {
+            case 1: return inputs.front();
+            case 2: return calculate_fixed<2>(inputs, power);
+            case 3: return calculate_fixed<3>(inputs, power);
+            case 4: return calculate_fixed<4>(inputs, power);
+            case 5: return calculate_fixed<5>(inputs, power);
+            case 6: return calculate_fixed<6>(inputs, power);
+            case 7: return calculate_fixed<7>(inputs, power);
+            case 8: return calculate_fixed<8>(inputs, power);
+            default: break;
+        }
+    }
+    auto level = inputs;
+    for (;;) {
+        for (size_t i = 0; i < level.size() - 1; i++) level[i] = glm::mix(level[i], level[i + 1], power);
+        level.resize(level.size() - 1);
+        if (level.size() == 1) return level.front();
+        if (callback) (*callback)(level);
+    }
+}
+
+double sc::bezier::solve(const std::vector<glm::dvec2> &inputs, double x) {
+    if (inputs.empty()) return x;
+    if (inputs.size() == 1) return inputs.front().y;
+    return calculate(inputs, solve_power(inputs, x)).y;
+}
+
+sc::bezier::inverse_table sc::bezier::inverse_table::build(const std::vector<glm::dvec2> &inputs) {
+    inverse_table result;
+    for (size_t i = 0; i <= resolution; i++) result.table[i] = static_cast<float>(solve(inputs, static_cast<double>(i) / static_cast<double>(resolution)));
+    for (size_t i = 0; i < resolution; i++) {
+        for (int j = 1; j < 4; j++) {
+            const auto x = (static_cast<double>(i) + static_cast<double>(j) / 4.0) / static_cast<double>(resolution);
+            result.max_error = glm::max(result.max_error, glm::abs(static_cast<double>(result.evaluate(static_cast<float>(x))) - solve(inputs, x)));
+        }
+    }
+    return result;
+}
+
+float sc::bezier::inverse_table::evaluate(const float &x) const {
+    const auto position = glm::clamp(x, 0.f, 1.f) * static_cast<float>(resolution);
+    const auto index = glm::min(static_cast<size_t>(position), resolution - 1);
+    const auto fraction = position - static_cast<float>(index);
+    return table[index] + (table[index + 1] - table[index]) * fraction;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <functional>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+namespace sc::bezier {
+
+    glm::dvec2 calculate(const std::vector<glm::dvec2> &inputs, double power, std::optional<std::function<void(const std::vector<glm::dvec2> &level)>> callback = std::nullopt);
+
+    template<size_t N>
+    constexpr glm::dvec2 calculate(const std::array<glm::dvec2, N> &inputs, const double &power) {
+        static_assert(N >= 1, "a curve needs at least one point");
+        std::array<double, N> x = { }, y = { };
+        for (size_t i = 0; i < N; i++) {
+            x[i] = inputs[i].x;
+            y[i] = inputs[i].y;
+        }
+        for (size_t level = N - 1; level > 0; level--) {
+            for (size_t i = 0; i < level; i++) {
+                x[i] = x[i] * (1.0 - power) + x[i + 1] * power;
+                y[i] = y[i] * (1.0 - power) + y[i + 1] * power;
+            }
+        }
+        return { x[0], y[0] };
+    }
+
+    template<size_t N>
+    void calculate(const std::array<glm::dvec2, N> &inputs, const double *powers, glm::dvec2 *outputs, const size_t &count) {
+        static_assert(N >= 1, "a curve needs at least one point");
+        constexpr size_t block = 8;
+        for (size_t start = 0; start < count; start += block) {
+            const auto width = std::min(block, count - start);
+            alignas(64) double power[block] = { }, x[N][block], y[N][block];
+            for (size_t k = 0; k < width; k++) power[k] = powers[start + k];
+            for (size_t i = 0; i < N; i++) {
+                for (size_t k = 0; k < block; k++) {
+                    x[i][k] = inputs[i].x;
+                    y[i][k] = inputs[i].y;
+                }
+            }
+            for (size_t level = N - 1; level > 0; level--) {
+                for (size_t i = 0; i < level; i++) {
+                    for (size_t k = 0; k < block; k++) {
+                        x[i][k] = x[i][k] * (1.0 - power[k]) + x[i + 1][k] * power[k];
+                        y[i][k] = y[i][k] * (1.0 - power[k]) + y[i + 1][k] * power[k];
+                    }
+                }
+            }
+            for (size_t k = 0; k < width; k++) outputs[start + k] = { x[0][k], y[0][k] };
+        }
+    }
+
+    /*
+     * calculate() takes the curve parameter t, so feeding it a pedal position only gives y(x) when the
+     * control points are evenly spaced along x. solve() finds t with x(t) = x by safeguarded Newton
+     * iteration and returns y(t); it assumes x(t) is monotone, which holds whenever the control points
+     * are sorted by x. inverse_table samples solve() on a uniform x grid at build time so that y(x)
+     * costs one lookup and one lerp. For a C2 curve the lerp error is at most h^2 / 8 * max|y''(x)|
+     * with h = 1 / resolution; max_error is the bound actually measured against solve() while building.
+     */
+
+    double solve(const std::vector<glm::dvec2> &inputs, double x);
+
+    struct inverse_table {
+
+        static constexpr size_t resolution = 1024;
+
+        std::array<float, resolution + 1> table;
+        double max_error = 0;
+
+        static inverse_table build(const std::vector<glm::dvec2> &inputs);
+
+        float evaluate(const float &x) const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include <spdlog/spdlog.h>
+
+#include "bezier.h"
+
+#include <glm/common.hpp>
+
+namespace sl = spdlog;
+
+int main() {
+    const std::vector<glm::dvec2> linear = { { 0, 0 }, { .2, .2 }, { .4, .4 }, { .6, .6 }, { .8, .8 }, { 1, 1 } };
+    for (int i = 0; i <= 100; i++) {
+        const auto x = i / 100.0;
+        if (glm::abs(sc::bezier::solve(linear, x) - x) > 1e-9) {
+            sl::error("Linear curve does not solve to identity at x = {}.", x);
+            return 1;
+        }
+    }
+    const std::vector<glm::dvec2> skewed = { { 0, 0 }, { .05, .3 }, { .1, .5 }, { .7, .6 }, { .9, .95 }, { 1, 1 } };
+    for (int i = 0; i <= 100; i++) {
+        const auto power = i / 100.0;
+        const auto point = sc::bezier::calculate(skewed, power);
+        if (glm::abs(sc::bezier::solve(skewed, point.x) - point.y) > 1e-9) {
+            sl::error("Solved curve misses the point at t = {}.", power);
+            return 1;
+        }
+    }
+    if (glm::abs(sc::bezier::calculate(skewed, .5).y - sc::bezier::solve(skewed, .5)) < 1e-3) {
+        sl::error("Skewed curve should differ between t and x parametrization.");
+        return 1;
+    }
+    const auto table = sc::bezier::inverse_table::build(skewed);
+    if (table.max_error > 1e-4) {
+        sl::error("Inverse table error bound is too loose: {}", table.max_error);
+        return 1;
+    }
+    for (int i = 0; i <= 10000; i++) {
+        const auto x = i / 10000.0;
+        if (glm::abs(table.evaluate(static_cast<float>(x)) - sc::bezier::solve(skewed, x)) > table.max_error * 1.5 + 1e-6) {
+            sl::error("Inverse table exceeds its error bound at x = {}.", x);
+            return 1;
+        }
+    }
+    for (size_t i = 1; i < table.table.size(); i++) {
+        if (table.table[i] < table.table[i - 1]) {
+            sl::error("Inverse table is not monotone at #{}.", i);
+            return 1;
+        }
+    }
+    sl::info("Inverse table error bound: {:.2e}", table.max_error);
+    return 0;
+}
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include <optional>
 #include <string>
 #include <functional>
+#include <atomic>
+#include <thread>
 
 #include <tl/expected.hpp>
 
@@ -168,6 +170,12 @@ namespace sc::boot {
     static tl::expected<bool, std::string> on_fixed_update();
     static tl::expected<bool, std::string> on_update(const glm::ivec2 &framebuffer_size, bool *const force_redraw = nullptr);
     static void on_shutdown();
+
+    #ifdef SC_FEATURE_HEADLESS
+    static std::optional<std::string> on_headless_startup();
+    static tl::expected<bool, std::string> on_headless_update();
+    static void on_headless_shutdown();
+    #endif
 }
 
 static tl::expected<bool, std::string> _sc_glfw_process_events(GLFWwindow *glfw_window) {
@@ -330,6 +338,42 @@ static std::optional<std::string> _sc_run(GLFWwindow *glfw_window, ImGuiContext
     return std::nullopt;
 }
 
+#ifdef SC_FEATURE_HEADLESS
+
+#ifndef SC_HEADLESS_UPDATE_MS
+#define SC_HEADLESS_UPDATE_MS 100
+#endif
+
+static tl::expected<bool, std::string> _sc_run_headless() {
+    bool attached = false;
+    DEFER({
+        if (!attached) sc::boot::on_headless_shutdown();
+    });
+    if (const auto err = sc::boot::on_headless_startup(); err.has_value()) return tl::make_unexpected(*err);
+    std::atomic_bool attach_requested = false;
+    #ifdef SC_FEATURE_SYSTEM_TRAY
+        sc::systray::enable([&attach_requested]() {
+            attach_requested = true;
+        });
+        DEFER(sc::systray::disable());
+    #endif
+    spdlog::info("Running headless.");
+    while (!attach_requested) {
+        const auto res = sc::boot::on_headless_update();
+        if (!res.has_value()) return tl::make_unexpected(res.error());
+        if (!*res) {
+            spdlog::warn("Quit signalled.");
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(SC_HEADLESS_UPDATE_MS));
+    }
+    spdlog::info("Attaching user interface.");
+    attached = true;
+    return true;
+}
+
+#endif
+
 #include "../sentry/sentry.h"
 
 #include <pystring.h>
@@ -349,10 +393,25 @@ static void _sc_print_publisher_info(int arg_c, char **arg_v) {
     std::cout << std::endl;
 }
 
+static int _sc_report_error(const std::string &err) {
+    spdlog::error("An error has occurred: {}", err);
+    std::stringstream ss;
+    ss << "This program experienced an error and was unable to continue running:";
+    ss << std::endl << std::endl;
+    ss << err.data();
+    #ifndef SC_FEATURE_NO_ERROR_MESSAGE
+        MessageBoxA(NULL, ss.str().data(), fmt::format("{} Error", VER_APP_NAME).data(), MB_OK | MB_ICONERROR);
+    #endif
+    return 1;
+}
+
 static int _sc_entry_point(int arg_c, char **arg_v) {
     #ifdef SC_FEATURE_SYSTEM_TRAY
     program.add_argument("--background").help("start in system tray, not visible").default_value(false).implicit_value(true);
     #endif
+    #ifdef SC_FEATURE_HEADLESS
+    program.add_argument("--headless").help("run without a window or graphics until the user interface is requested").default_value(false).implicit_value(true);
+    #endif
     try {
         program.parse_args(arg_c, arg_v);
     } catch (const std::runtime_error &err) {
@@ -375,17 +434,15 @@ static int _sc_entry_point(int arg_c, char **arg_v) {
         spdlog::critical("This application has been built in DEBUG mode!");
     #endif
     spdlog::info("Program version: {}", VER_APP_VER);
-    if (const auto err = _sc_bootstrap(_sc_run); err.has_value()) {
-        spdlog::error("An error has occurred: {}", *err);
-        std::stringstream ss;
-        ss << "This program experienced an error and was unable to continue running:";
-        ss << std::endl << std::endl;
-        ss << err.value().data();
-        #ifndef SC_FEATURE_NO_ERROR_MESSAGE
-            MessageBoxA(NULL, ss.str().data(), fmt::format("{} Error", VER_APP_NAME).data(), MB_OK | MB_ICONERROR);
-        #endif
-        return 1;
-    }
+    #ifdef SC_FEATURE_HEADLESS
+        #pragma message("[EON] Using headless service mode.")
+        if (program.get<bool>("--headless")) {
+            const auto res = _sc_run_headless();
+            if (!res.has_value()) return _sc_report_error(res.error());
+            if (!*res) return 0;
+        }
+    #endif
+    if (const auto err = _sc_bootstrap(_sc_run); err.has_value()) return _sc_report_error(*err);
     return 0;
 }
 
@@ -0,0 +1,156 @@
+#include "diagnostics.h"
+
+#include <algorithm>
+#include <deque>
+#include <cstring>
+
+#include <nlohmann/json.hpp>
+
+#include "../file/file.h"
+
+namespace sc::diagnostics {
+
+    static std::mutex registry_mutex;
+    static std::deque<call_site> registry;
+
+    static nlohmann::json histogram_to_json(const histogram &h) {
+        nlohmann::json buckets_doc = nlohmann::json::array();
+        for (size_t i = 0; i < h.buckets.size(); i++) {
+            buckets_doc.push_back({
+                { "le_ns", histogram::bucket_upper_bound(i).count() },
+                { "count", h.buckets[i].load() }
+            });
+        }
+        return {
+            { "count", h.count.load() },
+            { "mean_ns", h.mean().count() },
+            { "p50_ns", h.percentile(.5).count() },
+            { "p99_ns", h.percentile(.99).count() },
+            { "max_ns", h.max_ns.load() },
+            { "buckets", buckets_doc }
+        };
+    }
+}
+
+void sc::diagnostics::histogram::record(const std::chrono::nanoseconds &duration) {
+    const auto ns = static_cast<uint64_t>(duration.count() > 0 ? duration.count() : 0);
+    size_t bucket_i = 0;
+    for (auto us = ns / 1000; us && bucket_i < num_buckets - 1; us >>= 1) bucket_i++;
+    buckets[bucket_i].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(ns, std::memory_order_relaxed);
+    for (auto prev = max_ns.load(std::memory_order_relaxed); ns > prev && !max_ns.compare_exchange_weak(prev, ns, std::memory_order_relaxed););
+}
+
+void sc::diagnostics::histogram::reset() {
+    for (auto &bucket : buckets) bucket = 0;
+    count = 0;
+    total_ns = 0;
+    max_ns = 0;
+}
+
+std::chrono::nanoseconds sc::diagnostics::histogram::bucket_upper_bound(const size_t &bucket_i) {
+    return std::chrono::microseconds(1ull << bucket_i);
+}
+
+std::chrono::nanoseconds sc::diagnostics::histogram::percentile(const double &fraction) const {
+    const auto total = count.load(std::memory_order_relaxed);
+    if (total == 0) return std::chrono::nanoseconds(0);
+    const auto wanted = static_cast<uint64_t>(fraction * static_cast<double>(total));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < num_buckets; i++) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen > wanted) return std::min(bucket_upper_bound(i), std::chrono::nanoseconds(max_ns.load(std::memory_order_relaxed)));
+    }
+    return std::chrono::nanoseconds(max_ns.load(std::memory_order_relaxed));
+}
+
+std::chrono::nanoseconds sc::diagnostics::histogram::mean() const {
+    const auto total = count.load(std::memory_order_relaxed);
+    if (total == 0) return std::chrono::nanoseconds(0);
+    return std::chrono::nanoseconds(total_ns.load(std::memory_order_relaxed) / total);
+}
+
+sc::diagnostics::call_site::call_site(const std::string_view &lock_name, const std::string_view &file, const int &line) : lock_name(lock_name), file(file), line(line) {
+
+}
+
+sc::diagnostics::call_site &sc::diagnostics::register_site(const std::string_view &lock_name, const std::string_view &file, const int &line) {
+    std::lock_guard guard(registry_mutex);
+    for (auto &site : registry) {
+        if (site.line == line && site.file == file && site.lock_name == lock_name) return site;
+    }
+    return registry.emplace_back(lock_name, file, line);
+}
+
+std::vector<sc::diagnostics::call_site *> sc::diagnostics::sites() {
+    std::lock_guard guard(registry_mutex);
+    std::vector<call_site *> listed;
+    for (auto &site : registry) listed.push_back(&site);
+    return listed;
+}
+
+void sc::diagnostics::reset() {
+    std::lock_guard guard(registry_mutex);
+    for (auto &site : registry) {
+        site.wait.reset();
+        site.hold.reset();
+    }
+}
+
+std::string sc::diagnostics::export_json() {
+    nlohmann::json doc = nlohmann::json::array();
+    for (const auto site : sites()) {
+        doc.push_back({
+            { "lock", site->lock_name },
+            { "file", site->file },
+            { "line", site->line },
+            { "wait", histogram_to_json(site->wait) },
+            { "hold", histogram_to_json(site->hold) }
+        });
+    }
+    return doc.dump(4);
+}
+
+std::optional<std::string> sc::diagnostics::export_to(const std::filesystem::path &path) {
+    const auto doc_content = export_json();
+    std::vector<std::byte> doc_data(doc_content.size());
+    memcpy(doc_data.data(), doc_content.data(), doc_data.size());
+    if (const auto err = file::save(path, doc_data); err) return *err;
+    return std::nullopt;
+}
+
+sc::diagnostics::instrumented_mutex::instrumented_mutex(const std::string_view &name) : name_(name), unattributed_(register_site(name, "(unattributed)", 0)) {
+
+}
+
+void sc::diagnostics::instrumented_mutex::lock() {
+    lock(unattributed_);
+}
+
+void sc::diagnostics::instrumented_mutex::lock(call_site &site) {
+    const auto requested_at = std::chrono::steady_clock::now();
+    mutex_.lock();
+    acquired_at_ = std::chrono::steady_clock::now();
+    holder_ = &site;
+    site.wait.record(acquired_at_ - requested_at);
+}
+
+bool sc::diagnostics::instrumented_mutex::try_lock() {
+    if (!mutex_.try_lock()) return false;
+    acquired_at_ = std::chrono::steady_clock::now();
+    holder_ = &unattributed_;
+    unattributed_.wait.record(std::chrono::nanoseconds(0));
+    return true;
+}
+
+void sc::diagnostics::instrumented_mutex::unlock() {
+    const auto released_at = std::chrono::steady_clock::now();
+    if (holder_) holder_->hold.record(released_at - acquired_at_);
+    holder_ = nullptr;
+    mutex_.unlock();
+}
+
+const std::string &sc::diagnostics::instrumented_mutex::name() const {
+    return name_;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../defer.hpp"
+
+namespace sc::diagnostics {
+
+    struct histogram {
+
+        static constexpr size_t num_buckets = 24;
+
+        std::array<std::atomic<uint64_t>, num_buckets> buckets = { };
+        std::atomic<uint64_t> count = 0, total_ns = 0, max_ns = 0;
+
+        void record(const std::chrono::nanoseconds &duration);
+        void reset();
+        std::chrono::nanoseconds percentile(const double &fraction) const;
+        std::chrono::nanoseconds mean() const;
+
+        static std::chrono::nanoseconds bucket_upper_bound(const size_t &bucket_i);
+    };
+
+    struct call_site {
+
+        const std::string lock_name;
+        const std::string file;
+        const int line;
+
+        histogram wait, hold;
+
+        call_site(const std::string_view &lock_name, const std::string_view &file, const int &line);
+        call_site(const call_site &) = delete;
+        call_site &operator=(const call_site &) = delete;
+    };
+
+    call_site &register_site(const std::string_view &lock_name, const std::string_view &file, const int &line);
+    std::vector<call_site *> sites();
+    void reset();
+
+    std::string export_json();
+    std::optional<std::string> export_to(const std::filesystem::path &path);
+
+    class instrumented_mutex {
+        public:
+            explicit instrumented_mutex(const std::string_view &name);
+            instrumented_mutex(const instrumented_mutex &) = delete;
+            instrumented_mutex &operator=(const instrumented_mutex &) = delete;
+
+            void lock();
+            void lock(call_site &site);
+            bool try_lock();
+            void unlock();
+
+            const std::string &name() const;
+
+        private:
+            std::mutex mutex_;
+            const std::string name_;
+            call_site &unattributed_;
+            call_site *holder_ = nullptr;
+            std::chrono::steady_clock::time_point acquired_at_;
+    };
+
+    class site_lock_guard {
+        public:
+            site_lock_guard(instrumented_mutex &mutex, call_site &site) : mutex_(mutex) { mutex_.lock(site); }
+            ~site_lock_guard() { mutex_.unlock(); }
+            site_lock_guard(const site_lock_guard &) = delete;
+            site_lock_guard &operator=(const site_lock_guard &) = delete;
+        private:
+            instrumented_mutex &mutex_;
+    };
+}
+
+// Locks an instrumented mutex until the end of this scope, attributing wait and hold times to this line.
+#define SC_LOCK_GUARD(m) \
+    static auto &CONCAT(__lock_site__, __LINE__) = sc::diagnostics::register_site((m).name(), __FILE__, __LINE__); \
+    sc::diagnostics::site_lock_guard CONCAT(__lock_guard__, __LINE__)((m), CONCAT(__lock_site__, __LINE__))
@@ -1,5 +1,6 @@
 #include "file.h"
 
+#include <cstring>
 #include <fstream>
 
 tl::expected<std::vector<std::byte>, std::string> sc::file::load(const std::filesystem::path &path) {
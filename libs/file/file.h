@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include <filesystem>
+#include <memory>
 #include <optional>
 
 #include <tl/expected.hpp>
@@ -12,4 +13,25 @@ namespace sc::file {
 
     tl::expected<std::vector<std::byte>, std::string> load(const std::filesystem::path &path);
     std::optional<std::string> save(const std::filesystem::path &path, const std::vector<std::byte> &data);
+
+    struct mapping {
+
+        mapping(const mapping &) = delete;
+        mapping &operator=(const mapping &) = delete;
+        ~mapping();
+
+        const std::byte *data() const;
+        size_t size() const;
+
+        static tl::expected<std::shared_ptr<mapping>, std::string> open(const std::filesystem::path &path);
+
+    private:
+
+        mapping() = default;
+
+        const std::byte *view = nullptr;
+        size_t length = 0;
+        void *file_handle = nullptr;
+        void *mapping_handle = nullptr;
+    };
 }
\ No newline at end of file
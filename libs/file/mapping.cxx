@@ -0,0 +1,61 @@
+#include "file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+sc::file::mapping::~mapping() {
+#ifdef _WIN32
+    if (view) UnmapViewOfFile(view);
+    if (mapping_handle) CloseHandle(mapping_handle);
+    if (file_handle) CloseHandle(file_handle);
+#else
+    if (view) munmap(const_cast<std::byte *>(view), length);
+#endif
+}
+
+const std::byte *sc::file::mapping::data() const {
+    return view;
+}
+
+size_t sc::file::mapping::size() const {
+    return length;
+}
+
+tl::expected<std::shared_ptr<sc::file::mapping>, std::string> sc::file::mapping::open(const std::filesystem::path &path) {
+    std::shared_ptr<mapping> result(new mapping());
+#ifdef _WIN32
+    const auto file = CreateFileW(path.wstring().data(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return tl::make_unexpected("Unable to open file.");
+    result->file_handle = file;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) return tl::make_unexpected("Unable to determine file size.");
+    result->mapping_handle = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!result->mapping_handle) return tl::make_unexpected("Unable to map file.");
+    result->view = static_cast<const std::byte *>(MapViewOfFile(result->mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (!result->view) return tl::make_unexpected("Unable to map file.");
+    result->length = static_cast<size_t>(size.QuadPart);
+#else
+    const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return tl::make_unexpected("Unable to open file.");
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return tl::make_unexpected("Unable to determine file size.");
+    }
+    const auto view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) return tl::make_unexpected(std::strerror(errno));
+    result->view = static_cast<const std::byte *>(view);
+    result->length = static_cast<size_t>(info.st_size);
+#endif
+    return result;
+}
\ No newline at end of file
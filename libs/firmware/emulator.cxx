@@ -0,0 +1,123 @@
+#include "emulator.h"
+
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include <glm/common.hpp>
+
+sc::firmware::mk4::emulator::emulator(const size_t &num_axes) : axes(num_axes) {
+    for (auto &model : models) {
+        for (int i = 0; i < model.size(); i++) model[i] = { i / 5.f, i / 5.f };
+    }
+}
+
+void sc::firmware::mk4::emulator::set_input(const int &axis_i, const uint16_t &value) {
+    std::lock_guard guard(mutex);
+    if (axis_i < 0 || axis_i >= axes.size()) return;
+    axes[axis_i].input = value;
+    refresh_output(axes[axis_i]);
+}
+
+void sc::firmware::mk4::emulator::unplug() {
+    std::lock_guard guard(mutex);
+    unplugged = true;
+}
+
+void sc::firmware::mk4::emulator::refresh_output(axis_state &axis) {
+    if (!axis.enabled || axis.max <= axis.min) {
+        axis.output = 0;
+        return;
+    }
+    const float low = axis.min + (axis.max - axis.min) * (axis.deadzone / 100.f);
+    const float fraction = glm::clamp((axis.input - low) / glm::max(1.f, axis.max - low), 0.f, axis.limit / 100.f);
+    axis.output = static_cast<uint16_t>(glm::round(fraction * std::numeric_limits<uint16_t>::max()));
+}
+
+std::optional<std::string> sc::firmware::mk4::emulator::write(const std::array<std::byte, 64> &packet) {
+    std::lock_guard guard(mutex);
+    if (unplugged) return "Unable to send data to the device.";
+    std::array<std::byte, 64> reply;
+    memset(reply.data(), 0, reply.size());
+    if (memcmp("SC!", packet.data(), 3) == 0) {
+        memcpy(reply.data(), "SC#", 3);
+        memcpy(&reply[3], &communications_id, sizeof(communications_id));
+        memcpy(&reply[5], &packet[3], 55);
+        pending.push_back(reply);
+        return std::nullopt;
+    }
+    if (memcmp("SC", packet.data(), 2) != 0) return std::nullopt;
+    memcpy(reply.data(), packet.data(), 6);
+    const auto index = static_cast<int>(packet[9]);
+    const auto command = std::string_view(reinterpret_cast<const char *>(&packet[6]), 3);
+    if (packet[6] == static_cast<std::byte>('V')) {
+        memcpy(&reply[6], &std::get<0>(version), sizeof(uint16_t));
+        memcpy(&reply[8], &std::get<1>(version), sizeof(uint16_t));
+        memcpy(&reply[10], &std::get<2>(version), sizeof(uint16_t));
+    } else if (packet[6] == static_cast<std::byte>('S')) {
+        num_commits++;
+        reply[6] = static_cast<std::byte>(1);
+    } else if (command == "JAC") {
+        reply[6] = static_cast<std::byte>(axes.size());
+    } else if (command.substr(0, 2) == "JA") {
+        if (index < 0 || index >= axes.size()) return std::nullopt;
+        auto &axis = axes[index];
+        reply[6] = packet[9];
+        if (command == "JAS") {
+            reply[7] = static_cast<std::byte>(axis.enabled);
+            reply[8] = static_cast<std::byte>(axis.curve_i);
+            memcpy(&reply[9], &axis.min, sizeof(axis.min));
+            memcpy(&reply[11], &axis.max, sizeof(axis.max));
+            memcpy(&reply[13], &axis.input, sizeof(axis.input));
+            memcpy(&reply[15], &axis.output, sizeof(axis.output));
+            reply[17] = static_cast<std::byte>(axis.deadzone);
+            reply[18] = static_cast<std::byte>(axis.limit);
+        } else if (command == "JAE") {
+            axis.enabled = static_cast<bool>(packet[10]);
+            reply[7] = packet[10];
+        } else if (command == "JAR") {
+            memcpy(&axis.min, &packet[10], sizeof(axis.min));
+            memcpy(&axis.max, &packet[12], sizeof(axis.max));
+            axis.deadzone = static_cast<uint8_t>(packet[14]);
+            axis.limit = static_cast<uint8_t>(packet[15]);
+            memcpy(&reply[7], &packet[10], 6);
+        } else if (command == "JAB") {
+            axis.curve_i = static_cast<int8_t>(packet[10]);
+            reply[7] = packet[10];
+        } else return std::nullopt;
+        refresh_output(axis);
+    } else if (command.substr(0, 2) == "BA") {
+        if (index < 0 || index >= models.size()) return std::nullopt;
+        reply[6] = packet[9];
+        if (command == "BAM") {
+            memcpy(models[index].data(), &packet[10], sizeof(glm::vec2) * models[index].size());
+            memcpy(&reply[7], models[index].data(), sizeof(glm::vec2) * models[index].size());
+        } else if (command == "BAG") {
+            memcpy(&reply[7], models[index].data(), sizeof(glm::vec2) * models[index].size());
+        } else if (command == "BAU") {
+            memcpy(labels[index].data(), &packet[10], labels[index].size());
+            memcpy(&reply[7], labels[index].data(), labels[index].size());
+        } else if (command == "BAL") {
+            memcpy(&reply[7], labels[index].data(), labels[index].size());
+        } else return std::nullopt;
+    } else return std::nullopt;
+    pending.push_back(reply);
+    return std::nullopt;
+}
+
+tl::expected<std::optional<std::array<std::byte, 64>>, std::string> sc::firmware::mk4::emulator::read(const std::optional<int> &timeout) {
+    std::lock_guard guard(mutex);
+    if (unplugged) return tl::make_unexpected("Unable to read data from the device.");
+    if (pending.empty()) return std::nullopt;
+    const auto reply = pending.front();
+    pending.pop_front();
+    return reply;
+}
+
+tl::expected<std::shared_ptr<sc::firmware::mk4::device_handle>, std::string> sc::firmware::mk4::emulator::open(const std::shared_ptr<emulator> &device, const std::string_view &serial) {
+    auto handle = std::make_shared<device_handle>(0x16d0, 0x10db, "Sim Coaches", "Emulated MK4", fmt::format("emulated:{}", serial), serial, device);
+    const auto comm_res = handle->get_new_communications_id();
+    if (!comm_res.has_value()) return tl::make_unexpected(comm_res.error());
+    handle->_communications_id = *comm_res;
+    return handle;
+}
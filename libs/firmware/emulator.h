@@ -0,0 +1,49 @@
+#pragma once
+
+#include "mk4.h"
+
+#include <array>
+#include <deque>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace sc::firmware::mk4 {
+
+    struct emulator : device_handle::transport {
+
+        struct axis_state {
+
+            bool enabled = true;
+            int8_t curve_i = -1;
+            uint16_t min = 0, max = std::numeric_limits<uint16_t>::max();
+            uint16_t input = 0, output = 0;
+            uint8_t deadzone = 0, limit = 100;
+        };
+
+        std::mutex mutex;
+        std::tuple<uint16_t, uint16_t, uint16_t> version = { 4, 0, 0 };
+        std::vector<axis_state> axes;
+        std::array<std::array<glm::vec2, 6>, 5> models;
+        std::array<std::array<char, 50>, 5> labels = { };
+        int num_commits = 0;
+        bool unplugged = false;
+
+        emulator(const size_t &num_axes = 3);
+
+        void set_input(const int &axis_i, const uint16_t &value);
+        void unplug();
+
+        std::optional<std::string> write(const std::array<std::byte, 64> &packet) override;
+        tl::expected<std::optional<std::array<std::byte, 64>>, std::string> read(const std::optional<int> &timeout) override;
+
+        static tl::expected<std::shared_ptr<device_handle>, std::string> open(const std::shared_ptr<emulator> &device, const std::string_view &serial);
+
+    private:
+
+        uint16_t communications_id = 0x5a5a;
+        std::deque<std::array<std::byte, 64>> pending;
+
+        void refresh_output(axis_state &axis);
+    };
+}
@@ -18,8 +18,12 @@ sc::firmware::mk4::device_handle::device_handle(const uint16_t &vendor, const ui
 
 }
 
+sc::firmware::mk4::device_handle::device_handle(const uint16_t &vendor, const uint16_t &product, const std::string_view &org, const std::string_view &name, const std::string_view &uuid, const std::string_view &serial, const std::shared_ptr<transport> &link) : vendor(vendor), product(product), org(org), name(name), uuid(uuid), serial(serial), ptr(nullptr), link(link) {
+
+}
+
 sc::firmware::mk4::device_handle::~device_handle() {
-    hid_close(reinterpret_cast<hid_device *>(ptr));
+    if (ptr) hid_close(reinterpret_cast<hid_device *>(ptr));
 }
 
 tl::expected<std::vector<std::shared_ptr<sc::firmware::mk4::device_handle>>, std::string> sc::firmware::mk4::discover(const std::optional<std::vector<std::shared_ptr<device_handle>>> &existing) {
@@ -68,7 +72,8 @@ tl::expected<std::vector<std::shared_ptr<sc::firmware::mk4::device_handle>>, std
 }
 
 std::optional<std::string> sc::firmware::mk4::device_handle::write(const std::array<std::byte, 64> &packet) {
-    std::lock_guard guard(mutex);
+    SC_LOCK_GUARD(mutex);
+    if (link) return link->write(packet);
     std::vector<std::byte> buffer(packet.size() + 1);
     buffer[0] = static_cast<std::byte>(0x0);
     memcpy(&buffer[1], packet.data(), packet.size());
@@ -77,7 +82,8 @@ std::optional<std::string> sc::firmware::mk4::device_handle::write(const std::ar
 }
 
 tl::expected<std::optional<std::array<std::byte, 64>>, std::string> sc::firmware::mk4::device_handle::read(const std::optional<int> &timeout) {
-    std::lock_guard guard(mutex);
+    SC_LOCK_GUARD(mutex);
+    if (link) return link->read(timeout);
     std::array<std::byte, 64> buff_in;
     const auto num_bytes_read = hid_read_timeout(reinterpret_cast<hid_device *>(ptr), reinterpret_cast<unsigned char *>(buff_in.data()), buff_in.size(), timeout ? *timeout : 0);
     if (num_bytes_read == 0) return std::nullopt;
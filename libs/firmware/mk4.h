@@ -11,11 +11,21 @@
 #include <string>
 #include <memory>
 #include <limits>
+#include <vector>
+
+#include "../diagnostics/diagnostics.h"
 
 namespace sc::firmware::mk4 {
 
     struct device_handle {
 
+        struct transport {
+
+            virtual ~transport() = default;
+            virtual std::optional<std::string> write(const std::array<std::byte, 64> &packet) = 0;
+            virtual tl::expected<std::optional<std::array<std::byte, 64>>, std::string> read(const std::optional<int> &timeout) = 0;
+        };
+
         struct axis_info {
 
             bool enabled = false;
@@ -26,15 +36,17 @@ namespace sc::firmware::mk4 {
             uint8_t deadzone = 0, limit = 100;
         };
 
-        std::mutex mutex;
+        diagnostics::instrumented_mutex mutex { "device_handle::mutex" };
         const uint16_t vendor, product;
         const std::string org, name, uuid, serial;
         void * const ptr;
+        const std::shared_ptr<transport> link;
 
         uint16_t _communications_id = 0;
         uint16_t _next_packet_id = 0;
 
         device_handle(const uint16_t &vendor, const uint16_t &product, const std::string_view &org, const std::string_view &name, const std::string_view &uuid, const std::string_view &serial, void * const ptr);
+        device_handle(const uint16_t &vendor, const uint16_t &product, const std::string_view &org, const std::string_view &name, const std::string_view &uuid, const std::string_view &serial, const std::shared_ptr<transport> &link);
         device_handle(const device_handle&) = delete;
         device_handle &operator=(const device_handle &) = delete;
         ~device_handle();
@@ -0,0 +1,196 @@
+#include "input.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "../seqlock.hpp"
+
+namespace sc::input {
+
+    struct evdev_axis {
+
+        uint16_t code;
+        int32_t min, max;
+    };
+
+    static bool test_bit(const std::vector<uint8_t> &bits, const size_t &bit) {
+        return bit / 8 < bits.size() && (bits[bit / 8] >> (bit % 8)) & 1;
+    }
+
+    static float normalize_axis(const evdev_axis &axis, const int32_t &value) {
+        if (axis.max <= axis.min) return 0.f;
+        return std::clamp((static_cast<float>(value) - static_cast<float>(axis.min)) / static_cast<float>(axis.max - axis.min), 0.f, 1.f);
+    }
+
+    struct evdev_source : source {
+
+        const std::string device_name;
+        const int notify_fd;
+        int device_fd = -1;
+        std::vector<evdev_axis> axes;
+        std::array<int16_t, ABS_CNT> slots;
+        sample current;
+        seqlock<sample> published;
+        std::atomic_bool is_connected = false;
+        std::atomic_bool working = true;
+        std::thread worker;
+
+        evdev_source(const std::string_view &device_name, const int &notify_fd) : device_name(device_name), notify_fd(notify_fd) {
+            worker = std::thread([this]() {
+                work();
+            });
+        }
+
+        ~evdev_source() {
+            working = false;
+            if (worker.joinable()) worker.join();
+            close_device();
+            close(notify_fd);
+        }
+
+        std::string_view name() const override {
+            return "evdev";
+        }
+
+        bool connected() const override {
+            return is_connected;
+        }
+
+        std::optional<sample> latest() override {
+            if (!is_connected) return std::nullopt;
+            return published.load();
+        }
+
+        bool open_device(const std::filesystem::path &path) {
+            const auto fd = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+            if (fd < 0) return false;
+            std::array<char, 256> name = { 0 };
+            if (ioctl(fd, EVIOCGNAME(name.size() - 1), name.data()) < 0 || device_name != name.data()) {
+                close(fd);
+                return false;
+            }
+            int clock_id = CLOCK_MONOTONIC;
+            if (ioctl(fd, EVIOCSCLOCKID, &clock_id) < 0) spdlog::warn("Unable to switch {} to monotonic timestamps.", path.string());
+            std::vector<uint8_t> abs_bits(ABS_CNT / 8 + 1);
+            if (ioctl(fd, EVIOCGBIT(EV_ABS, abs_bits.size()), abs_bits.data()) < 0) {
+                close(fd);
+                return false;
+            }
+            axes.clear();
+            slots.fill(-1);
+            for (uint16_t code = 0; code < ABS_CNT && axes.size() < max_axes; code++) {
+                if (!test_bit(abs_bits, code) || (code >= ABS_HAT0X && code <= ABS_HAT3Y)) continue;
+                input_absinfo info;
+                if (ioctl(fd, EVIOCGABS(code), &info) < 0) continue;
+                slots[code] = static_cast<int16_t>(axes.size());
+                axes.push_back({ code, info.minimum, info.maximum });
+                current.axes[axes.size() - 1] = normalize_axis(axes.back(), info.value);
+            }
+            device_fd = fd;
+            current.num_axes = axes.size();
+            current.time = std::chrono::steady_clock::now();
+            current.sequence++;
+            published.store(current);
+            is_connected = true;
+            spdlog::debug("Opened evdev device {} with {} axes.", path.string(), axes.size());
+            notify(true);
+            return true;
+        }
+
+        void close_device() {
+            if (device_fd < 0) return;
+            close(device_fd);
+            device_fd = -1;
+            if (is_connected.exchange(false)) notify(false);
+        }
+
+        void scan() {
+            std::error_code ec;
+            for (const auto &entry : std::filesystem::directory_iterator("/dev/input", ec)) {
+                if (entry.path().filename().string().rfind("event", 0) != 0) continue;
+                if (open_device(entry.path())) return;
+            }
+        }
+
+        void resync() {
+            for (const auto &axis : axes) {
+                input_absinfo info;
+                if (ioctl(device_fd, EVIOCGABS(axis.code), &info) == 0) current.axes[slots[axis.code]] = normalize_axis(axis, info.value);
+            }
+        }
+
+        void drain_device() {
+            std::array<input_event, 64> events;
+            for (;;) {
+                const auto num_bytes = read(device_fd, events.data(), sizeof(events));
+                if (num_bytes < 0) {
+                    if (errno == EAGAIN || errno == EINTR) return;
+                    spdlog::debug("Lost evdev device: {}", strerror(errno));
+                    close_device();
+                    return;
+                }
+                if (num_bytes == 0) return;
+                for (size_t i = 0; i < num_bytes / sizeof(input_event); i++) {
+                    const auto &event = events[i];
+                    if (event.type == EV_ABS && event.code < ABS_CNT && slots[event.code] >= 0) current.axes[slots[event.code]] = normalize_axis(axes[slots[event.code]], event.value);
+                    else if (event.type == EV_SYN && event.code == SYN_DROPPED) resync();
+                    else if (event.type == EV_SYN && event.code == SYN_REPORT) {
+                        current.time = std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(event.input_event_sec) + std::chrono::microseconds(event.input_event_usec)));
+                        current.sequence++;
+                        published.store(current);
+                    }
+                }
+            }
+        }
+
+        bool drain_notifications() {
+            std::array<char, 4096> buffer;
+            bool changed = false;
+            while (read(notify_fd, buffer.data(), buffer.size()) > 0) changed = true;
+            return changed;
+        }
+
+        void work() {
+            bool rescan = true;
+            while (working) {
+                if (device_fd < 0 && rescan) {
+                    scan();
+                    rescan = false;
+                }
+                std::array<pollfd, 2> fds = { pollfd { notify_fd, POLLIN, 0 }, pollfd { device_fd, POLLIN, 0 } };
+                if (poll(fds.data(), device_fd < 0 ? 1 : 2, 100) <= 0) continue;
+                if (fds[0].revents & POLLIN) rescan = drain_notifications() || rescan;
+                if (device_fd >= 0 && fds[1].revents & (POLLIN | POLLERR | POLLHUP)) {
+                    drain_device();
+                    if (device_fd < 0) rescan = true;
+                }
+            }
+        }
+    };
+}
+
+tl::expected<std::unique_ptr<sc::input::source>, std::string> sc::input::create_evdev(const std::string_view &device_name) {
+    const auto notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notify_fd < 0) return tl::make_unexpected(fmt::format("Unable to create inotify instance: {}", strerror(errno)));
+    if (inotify_add_watch(notify_fd, "/dev/input", IN_CREATE | IN_ATTRIB) < 0) {
+        const auto reason = fmt::format("Unable to watch /dev/input: {}", strerror(errno));
+        close(notify_fd);
+        return tl::make_unexpected(reason);
+    }
+    return std::make_unique<evdev_source>(device_name, notify_fd);
+}
\ No newline at end of file
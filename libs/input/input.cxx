@@ -0,0 +1,11 @@
+#include "input.h"
+
+void sc::input::source::set_connection_callback(const connection_callback &callback) {
+    std::lock_guard guard(callback_mutex);
+    this->callback = callback;
+}
+
+void sc::input::source::notify(const bool &connected) {
+    std::lock_guard guard(callback_mutex);
+    if (callback) callback(connected);
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <tl/expected.hpp>
+
+namespace sc::input {
+
+    static constexpr size_t max_axes = 8;
+
+    struct sample {
+
+        std::chrono::steady_clock::time_point time;
+        uint64_t sequence = 0;
+        size_t num_axes = 0;
+        std::array<float, max_axes> axes = { 0 };
+    };
+
+    struct source {
+
+        using connection_callback = std::function<void(const bool &connected)>;
+
+        virtual ~source() = default;
+        virtual std::string_view name() const = 0;
+        virtual bool connected() const = 0;
+        virtual std::optional<sample> latest() = 0;
+
+        void set_connection_callback(const connection_callback &callback);
+
+    protected:
+
+        void notify(const bool &connected);
+
+    private:
+
+        std::mutex callback_mutex;
+        connection_callback callback;
+    };
+
+    std::unique_ptr<source> create_synthetic(const size_t &num_axes, const std::chrono::nanoseconds &period);
+
+#ifdef _WIN32
+    tl::expected<std::unique_ptr<source>, std::string> create_winmm(const std::string_view &device_name);
+#endif
+
+#ifdef __linux__
+    tl::expected<std::unique_ptr<source>, std::string> create_evdev(const std::string_view &device_name);
+#endif
+}
\ No newline at end of file
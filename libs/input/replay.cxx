@@ -0,0 +1,105 @@
+#include "replay.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../file/file.h"
+
+namespace sc::input {
+
+    struct recording_header {
+
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint32_t num_axes;
+        uint32_t reserved;
+        uint64_t num_samples;
+    };
+
+    static_assert(sizeof(recording_header) == 24, "recording headers are written straight to disk");
+}
+
+size_t sc::input::recording::size() const {
+    return times.size();
+}
+
+void sc::input::recording::append(const sample &value, const std::chrono::steady_clock::time_point &start) {
+    if (times.empty()) num_axes = std::min(value.num_axes, max_axes);
+    times.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(value.time - start));
+    for (size_t i = 0; i < num_axes; i++) values.push_back(i < value.num_axes ? value.axes[i] : 0.f);
+}
+
+sc::input::sample sc::input::recording::at(const size_t &i) const {
+    sample result;
+    result.time = std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(times[i]));
+    result.sequence = i + 1;
+    result.num_axes = num_axes;
+    std::copy_n(values.begin() + i * num_axes, num_axes, result.axes.begin());
+    return result;
+}
+
+tl::expected<sc::input::recording, std::string> sc::input::recording::load(const std::filesystem::path &path) {
+    const auto load_res = file::load(path);
+    if (!load_res.has_value()) return tl::make_unexpected(load_res.error());
+    const auto &data = *load_res;
+    recording_header header;
+    if (data.size() < sizeof(header)) return tl::make_unexpected("Recording is too short.");
+    memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != expected_magic || header.version != expected_version) return tl::make_unexpected("Recording has an unsupported format.");
+    if (header.num_axes > max_axes) return tl::make_unexpected("Recording has too many axes.");
+    const auto times_size = header.num_samples * sizeof(int64_t);
+    const auto values_size = header.num_samples * header.num_axes * sizeof(float);
+    if (data.size() != sizeof(header) + times_size + values_size) return tl::make_unexpected("Recording has an unexpected size.");
+    recording result;
+    result.num_axes = header.num_axes;
+    std::vector<int64_t> times(header.num_samples);
+    memcpy(times.data(), data.data() + sizeof(header), times_size);
+    result.times.reserve(times.size());
+    for (const auto &time : times) result.times.push_back(std::chrono::nanoseconds(time));
+    result.values.resize(header.num_samples * header.num_axes);
+    memcpy(result.values.data(), data.data() + sizeof(header) + times_size, values_size);
+    return result;
+}
+
+std::optional<std::string> sc::input::recording::save(const std::filesystem::path &path) const {
+    const recording_header header = { expected_magic, expected_version, static_cast<uint32_t>(num_axes), 0, times.size() };
+    std::vector<std::byte> data(sizeof(header) + times.size() * sizeof(int64_t) + values.size() * sizeof(float));
+    memcpy(data.data(), &header, sizeof(header));
+    for (size_t i = 0; i < times.size(); i++) {
+        const int64_t time = times[i].count();
+        memcpy(data.data() + sizeof(header) + i * sizeof(time), &time, sizeof(time));
+    }
+    memcpy(data.data() + sizeof(header) + times.size() * sizeof(int64_t), values.data(), values.size() * sizeof(float));
+    return file::save(path, data);
+}
+
+sc::input::replay_source::replay_source(std::shared_ptr<const recording> samples) : samples(std::move(samples)) {
+
+}
+
+std::string_view sc::input::replay_source::name() const {
+    return "replay";
+}
+
+bool sc::input::replay_source::connected() const {
+    return samples->size() > 0;
+}
+
+std::optional<sc::input::sample> sc::input::replay_source::latest() {
+    if (samples->size() == 0) return std::nullopt;
+    const auto i = std::min(next, samples->size() - 1);
+    if (next < samples->size()) next++;
+    return samples->at(i);
+}
+
+size_t sc::input::replay_source::position() const {
+    return next;
+}
+
+bool sc::input::replay_source::finished() const {
+    return next >= samples->size();
+}
+
+void sc::input::replay_source::rewind() {
+    next = 0;
+}
\ No newline at end of file
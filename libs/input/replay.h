@@ -0,0 +1,44 @@
+#pragma once
+
+#include "input.h"
+
+#include <filesystem>
+#include <vector>
+
+namespace sc::input {
+
+    struct recording {
+
+        static constexpr std::array<char, 4> expected_magic = { 'S', 'C', 'I', 'R' };
+        static constexpr uint32_t expected_version = 1;
+
+        size_t num_axes = 0;
+        std::vector<std::chrono::nanoseconds> times;
+        std::vector<float> values;
+
+        size_t size() const;
+        void append(const sample &value, const std::chrono::steady_clock::time_point &start);
+        sample at(const size_t &i) const;
+
+        static tl::expected<recording, std::string> load(const std::filesystem::path &path);
+        std::optional<std::string> save(const std::filesystem::path &path) const;
+    };
+
+    struct replay_source : source {
+
+        replay_source(std::shared_ptr<const recording> samples);
+
+        std::string_view name() const override;
+        bool connected() const override;
+        std::optional<sample> latest() override;
+
+        size_t position() const;
+        bool finished() const;
+        void rewind();
+
+    private:
+
+        const std::shared_ptr<const recording> samples;
+        size_t next = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "input.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#include "../seqlock.hpp"
+
+namespace sc::input {
+
+    struct synthetic_source : source {
+
+        const size_t num_axes;
+        const std::chrono::nanoseconds period;
+        seqlock<sample> published;
+        std::atomic_bool working = true;
+        std::thread worker;
+
+        synthetic_source(const size_t &num_axes, const std::chrono::nanoseconds &period) : num_axes(std::min(num_axes, max_axes)), period(period) {
+            worker = std::thread([this]() {
+                work();
+            });
+        }
+
+        ~synthetic_source() {
+            working = false;
+            if (worker.joinable()) worker.join();
+        }
+
+        std::string_view name() const override {
+            return "synthetic";
+        }
+
+        bool connected() const override {
+            return true;
+        }
+
+        std::optional<sample> latest() override {
+            if (published.sequence() == 0) return std::nullopt;
+            return published.load();
+        }
+
+        void work() {
+            sample current;
+            current.num_axes = num_axes;
+            const auto start = std::chrono::steady_clock::now();
+            auto next_sample = start;
+            while (working) {
+                current.time = std::chrono::steady_clock::now();
+                current.sequence++;
+                const auto phase = std::chrono::duration<double>(current.time - start).count();
+                for (size_t i = 0; i < num_axes; i++) current.axes[i] = static_cast<float>(.5 + .5 * std::sin(phase * (i + 1) * 3.14159265358979));
+                published.store(current);
+                next_sample += period;
+                const auto now = std::chrono::steady_clock::now();
+                if (next_sample < now) next_sample = now;
+                else std::this_thread::sleep_until(next_sample);
+            }
+        }
+    };
+}
+
+std::unique_ptr<sc::input::source> sc::input::create_synthetic(const size_t &num_axes, const std::chrono::nanoseconds &period) {
+    return std::make_unique<synthetic_source>(num_axes, period);
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "input.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <locale>
+#include <codecvt>
+
+#define WIN32_LEAN_AND_MEAN
+
+#include <windows.h>
+#include <mmsystem.h>
+#include <cfgmgr32.h>
+
+#include <spdlog/spdlog.h>
+
+#include "../winreg.hpp"
+
+#undef min
+#undef max
+
+namespace sc::input {
+
+    static constexpr auto scan_interval = std::chrono::seconds(1);
+    static constexpr auto notified_scan_interval = std::chrono::seconds(2);
+    static const GUID hid_interface_class = { 0x4d1e55b2, 0xf16f, 0x11cf, { 0x88, 0xcb, 0x00, 0x11, 0x11, 0x00, 0x00, 0x30 } };
+
+    struct joystick {
+
+        UINT id;
+        JOYCAPSW caps;
+    };
+
+    static std::optional<std::wstring> read_registry_string(const std::wstring &path, const std::wstring &value_name) {
+        for (const auto &root : { HKEY_LOCAL_MACHINE, HKEY_CURRENT_USER }) {
+            winreg::RegKey key;
+            if (!key.TryOpen(root, path, KEY_READ)) continue;
+            if (auto value = key.TryGetStringValue(value_name); value) return value;
+        }
+        return std::nullopt;
+    }
+
+    static std::optional<std::string> get_joystick_name(const joystick &device) {
+        const auto oem_key = read_registry_string(std::wstring(L"System\\CurrentControlSet\\Control\\MediaResources\\Joystick\\") + device.caps.szRegKey + L"\\CurrentJoystickSettings", L"Joystick" + std::to_wstring(device.id + 1) + L"OEMName");
+        if (!oem_key) return std::nullopt;
+        const auto oem_name = read_registry_string(L"System\\CurrentControlSet\\Control\\MediaProperties\\PrivateProperties\\Joystick\\OEM\\" + *oem_key, L"OEMName");
+        if (!oem_name) return std::nullopt;
+        return std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>().to_bytes(*oem_name);
+    }
+
+    static std::optional<joystick> find_joystick(const std::string_view &device_name) {
+        joyConfigChanged(0);
+        for (UINT id = 0; id < joyGetNumDevs(); id++) {
+            joystick device { id };
+            if (joyGetDevCapsW(id, &device.caps, sizeof(device.caps)) != JOYERR_NOERROR) continue;
+            JOYINFOEX info { sizeof(JOYINFOEX), JOY_RETURNALL };
+            if (joyGetPosEx(id, &info) != JOYERR_NOERROR) continue;
+            if (get_joystick_name(device) == device_name) return device;
+        }
+        return std::nullopt;
+    }
+
+    static float normalize_axis(const DWORD &value, const UINT &min, const UINT &max) {
+        if (max <= min) return 0.f;
+        const auto fraction = (static_cast<float>(value) - static_cast<float>(min)) / static_cast<float>(max - min);
+        return fraction < 0.f ? 0.f : (fraction > 1.f ? 1.f : fraction);
+    }
+
+    struct winmm_source : source {
+
+        const std::string device_name;
+        std::optional<joystick> device;
+        std::atomic_bool is_connected = false;
+        std::atomic_bool rescan = true;
+        HCMNOTIFICATION notification = nullptr;
+        std::chrono::steady_clock::time_point last_scan;
+        uint64_t sequence = 0;
+
+        winmm_source(const std::string_view &device_name) : device_name(device_name) {
+            CM_NOTIFY_FILTER filter;
+            memset(&filter, 0, sizeof(filter));
+            filter.cbSize = sizeof(filter);
+            filter.FilterType = CM_NOTIFY_FILTER_TYPE_DEVICEINTERFACE;
+            filter.u.DeviceInterface.ClassGuid = hid_interface_class;
+            if (CM_Register_Notification(&filter, this, on_device_change, &notification) != CR_SUCCESS) {
+                notification = nullptr;
+                spdlog::warn("Unable to register for device notifications, falling back to periodic joystick scans.");
+            }
+        }
+
+        ~winmm_source() {
+            if (notification) CM_Unregister_Notification(notification);
+        }
+
+        static DWORD CALLBACK on_device_change(HCMNOTIFICATION notification, PVOID context, CM_NOTIFY_ACTION action, PCM_NOTIFY_EVENT_DATA data, DWORD data_size) {
+            if (action == CM_NOTIFY_ACTION_DEVICEINTERFACEARRIVAL || action == CM_NOTIFY_ACTION_DEVICEINTERFACEREMOVAL) static_cast<winmm_source *>(context)->rescan = true;
+            return ERROR_SUCCESS;
+        }
+
+        std::string_view name() const override {
+            return "winmm";
+        }
+
+        bool connected() const override {
+            return is_connected;
+        }
+
+        std::optional<sample> latest() override {
+            const auto now = std::chrono::steady_clock::now();
+            if (!device && (rescan.exchange(false) || now - last_scan >= (notification ? notified_scan_interval : scan_interval))) {
+                last_scan = now;
+                if (device = find_joystick(device_name); device) {
+                    is_connected = true;
+                    notify(true);
+                }
+            }
+            if (!device) return std::nullopt;
+            JOYINFOEX info { sizeof(JOYINFOEX), JOY_RETURNALL };
+            if (joyGetPosEx(device->id, &info) != JOYERR_NOERROR) {
+                device.reset();
+                is_connected = false;
+                notify(false);
+                return std::nullopt;
+            }
+            sample latest;
+            latest.time = now;
+            latest.sequence = ++sequence;
+            latest.num_axes = std::min(static_cast<size_t>(device->caps.wNumAxes), static_cast<size_t>(6));
+            latest.axes[0] = normalize_axis(info.dwXpos, device->caps.wXmin, device->caps.wXmax);
+            latest.axes[1] = normalize_axis(info.dwYpos, device->caps.wYmin, device->caps.wYmax);
+            latest.axes[2] = normalize_axis(info.dwZpos, device->caps.wZmin, device->caps.wZmax);
+            latest.axes[3] = normalize_axis(info.dwRpos, device->caps.wRmin, device->caps.wRmax);
+            latest.axes[4] = normalize_axis(info.dwUpos, device->caps.wUmin, device->caps.wUmax);
+            latest.axes[5] = normalize_axis(info.dwVpos, device->caps.wVmin, device->caps.wVmax);
+            return latest;
+        }
+    };
+}
+
+tl::expected<std::unique_ptr<sc::input::source>, std::string> sc::input::create_winmm(const std::string_view &device_name) {
+    return std::make_unique<winmm_source>(device_name);
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include <spdlog/spdlog.h>
+
+#include "iracing.h"
+#include "lz.h"
+#include "recorder.h"
+#include "replay.h"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace sl = spdlog;
+
+static std::shared_ptr<sc::iracing::recording> synthesize(const int32_t &num_ticks, const int32_t &num_channels) {
+    auto session = std::make_shared<sc::iracing::recording>();
+    for (int32_t i = 0; i < num_channels; i++) {
+        sc::iracing::recorded_channel channel;
+        channel.name = i == 0 ? "RPM" : fmt::format("Channel{}", i);
+        channel.type = sc::iracing::variable_type::single;
+        channel.count = i % 8 == 7 ? 6 : 1;
+        for (int32_t tick = 0; tick < num_ticks; tick++) {
+            channel.ticks.push_back(tick);
+            for (int32_t j = 0; j < channel.count; j++) {
+                const auto value = i == 0 ? static_cast<float>(tick) : std::sin(static_cast<float>(tick * channel.count + j) / (50.f + static_cast<float>(i)));
+                channel.values.insert(channel.values.end(), reinterpret_cast<const std::byte *>(&value), reinterpret_cast<const std::byte *>(&value) + sizeof(value));
+            }
+        }
+        session->channels.push_back(std::move(channel));
+    }
+    return session;
+}
+
+int main() {
+    const int32_t num_ticks = 6000, num_channels = 64;
+    const auto session = synthesize(num_ticks, num_channels);
+    {
+        const auto path = std::filesystem::temp_directory_path() / "bench_iracing.scit";
+        auto writer = sc::iracing::recording_writer::open(path, session->channels);
+        if (!writer.has_value()) {
+            sl::error("Unable to open recording: {}", writer.error());
+            return 1;
+        }
+        size_t raw = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < session->channels.size(); i++) {
+            const auto &channel = session->channels[i];
+            for (size_t first = 0; first < channel.ticks.size(); first += sc::iracing::recorder::default_block_samples) {
+                const auto count = std::min(sc::iracing::recorder::default_block_samples, channel.ticks.size() - first);
+                if (const auto err = (*writer)->write(i, channel.ticks.data() + first, channel.values.data() + first * channel.width(), count); err) {
+                    sl::error("Unable to write recording: {}", *err);
+                    return 1;
+                }
+            }
+            raw += channel.ticks.size() * sizeof(int32_t) + channel.values.size();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        sl::info("Recorder: {:.1f} MB/s, {} bytes into {} bytes.", static_cast<double>(raw) / elapsed.count() / 1e6, raw, (*writer)->bytes_written());
+        writer->reset();
+        const auto load_start = std::chrono::steady_clock::now();
+        const auto loaded = sc::iracing::recording::load(path);
+        const std::chrono::duration<double> load_elapsed = std::chrono::steady_clock::now() - load_start;
+        std::filesystem::remove(path);
+        if (!loaded.has_value()) {
+            sl::error("Unable to load recording: {}", loaded.error());
+            return 1;
+        }
+        sl::info("Reader: {:.1f} MB/s.", static_cast<double>(raw) / load_elapsed.count() / 1e6);
+    }
+    auto player = sc::iracing::replay::open(session, "/sc-bench-iracing");
+    if (!player.has_value()) {
+        sl::error("Unable to open replay: {}", player.error());
+        return 1;
+    }
+    auto rpm = sc::iracing::subscribe<float>("RPM", 1, 8192);
+    sc::iracing::startup((*player)->factory());
+    while (sc::iracing::get_status() == sc::iracing::status::searching) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    for (const auto speed : { 100.0, 1000.0, 0.0 }) {
+        int32_t tick;
+        float value;
+        while (rpm.try_pop(tick, &value));
+        const auto start = std::chrono::steady_clock::now();
+        (*player)->play(speed);
+        while (!(*player)->finished()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        size_t received = 0;
+        while (rpm.try_pop(tick, &value)) received++;
+        sl::info("Replay at {}x: {} of {} ticks delivered in {:.3f}s ({:.0f} ticks/s).", speed, received, num_ticks, elapsed.count(), static_cast<double>(received) / elapsed.count());
+    }
+    sc::iracing::shutdown();
+    return 0;
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "iracing.h"
+#include "source.h"
 
 #include <vector>
 #include <mutex>
@@ -10,28 +11,26 @@
 #include <map>
 #include <string>
 #include <atomic>
+#include <array>
+#include <cstring>
 
 #include <spdlog/spdlog.h>
 #include <spdlog/fmt/bin_to_hex.h>
 
-#include <windows.h>
-
 #include "../defer.hpp"
+#include "../mpsc_queue.hpp"
 
 namespace sc::iracing {
 
-    static const auto mapped_file_name = "Local\\IRSDKMemMapFileName";
-    static const size_t mapped_file_length = 1164 * 1024;
-    static const auto data_event_name = "Local\\IRSDKDataValidEvent";
-    static const auto broadcast_message_name = "IRSDK_BROADCASTMSG";
-
     static std::thread worker;
+    static source_factory open_source;
     static std::atomic_bool working = false;
 
     static std::atomic<status> current_status = status::stopped;
 
     std::mutex tele_members_mutex;
     std::map<std::string, int> tele_members;
+    std::unordered_map<std::string, variable> tele_layout;
 
     std::atomic<bool> tele_prev_valid = false;
     std::atomic<float> tele_lap_percent = 0;
@@ -48,48 +47,87 @@ namespace sc::iracing {
 
     std::vector<moment> moments;
 
-    struct variable_buffer_header {
+    struct resolved_variables {
 
-        int32_t tick_count;
-        int32_t data_offset;
-        uint32_t _padding_1[2];
+        accessor<float> lap_percent, rpm, speed;
+        accessor<int32_t> gear;
     };
 
-    struct header {
-
-        int32_t version;
-        int32_t status;
-        int32_t tick_rate;
-        int32_t session_info_update;
-        int32_t session_info_length;
-        int32_t session_info_offset;
-        int32_t num_variables;
-        int32_t variables_header_offset;
-        int32_t num_buffers;
-        int32_t buffer_length;
-        uint32_t _padding_1[2];
-        variable_buffer_header buffers[4];
-    };
+    static variable_index index;
+    static resolved_variables resolved;
+    static std::optional<std::array<int32_t, 3>> indexed_layout;
+    static std::vector<std::byte> snapshot;
+    static std::optional<int32_t> snapshot_tick;
+    static mpsc_queue<std::shared_ptr<channel>, 64> pending_channels;
+    static std::vector<std::shared_ptr<channel>> channels;
+
+    static void resolve_channel(channel &target) {
+        const auto found = index.variables.find(target.name);
+        if (found == index.variables.end() || found->second.type != target.type) {
+            target.offset = -1;
+            target.available = 0;
+            target.resolved = false;
+            return;
+        }
+        target.offset = found->second.offset;
+        target.available = std::min(found->second.count, target.count);
+        target.resolved = true;
+    }
 
-    struct variable_header {
+    static void publish_channels() {
+        while (auto attached = pending_channels.try_pop()) {
+            resolve_channel(**attached);
+            channels.push_back(std::move(*attached));
+        }
+        channels.erase(std::remove_if(channels.begin(), channels.end(), [](const auto &target) { return !target->attached; }), channels.end());
+        for (const auto &target : channels) {
+            if (target->offset >= 0) target->publish(*snapshot_tick, snapshot.data());
+        }
+    }
 
-        int32_t type;
-        int32_t offset;
-        int32_t count;
-        std::byte count_as_time;
-        uint8_t _padding_1[3];
-        std::byte name[32];
-        std::byte description[64];
-        std::byte unit[32];
-    };
+    static void build_index(const header *telemetry_header, const variable_header *variables) {
+        snapshot.assign(static_cast<size_t>(std::max(telemetry_header->buffer_length, 0)), std::byte(0));
+        snapshot_tick.reset();
+        index.variables.clear();
+        std::map<std::string, int> members;
+        for (int i = 0; i < telemetry_header->num_variables; i++) {
+            if (variables[i].type < 0 || variables[i].type > static_cast<int32_t>(variable_type::dual) || variables[i].offset < 0 || variables[i].count <= 0) continue;
+            if (static_cast<size_t>(variables[i].offset) + static_cast<size_t>(variables[i].count) * size_of(static_cast<variable_type>(variables[i].type)) > snapshot.size()) continue;
+            const auto name_data = reinterpret_cast<const char *>(variables[i].name);
+            std::string name(name_data, strnlen(name_data, sizeof(variables[i].name)));
+            index.variables[name] = { static_cast<variable_type>(variables[i].type), variables[i].offset, variables[i].count };
+            members[name] = variables[i].type;
+        }
+        resolved.lap_percent = index.resolve<float>("LapDistPct");
+        resolved.rpm = index.resolve<float>("RPM");
+        resolved.speed = index.resolve<float>("Speed");
+        resolved.gear = index.resolve<int32_t>("Gear");
+        for (const auto &target : channels) resolve_channel(*target);
+        {
+            std::lock_guard guard(tele_members_mutex);
+            tele_members = std::move(members);
+            tele_layout = index.variables;
+        }
+        spdlog::debug("Indexed {} iRacing variables.", index.variables.size());
+    }
 
-    static variable_buffer_header *find_recent_valid_buffer(header *telemetry_header) {
-        std::vector<variable_buffer_header *> sorted_buffers;
-        for (int i = 0; i < telemetry_header->num_buffers; i++) sorted_buffers.push_back(&telemetry_header->buffers[i]);
-        std::sort(sorted_buffers.begin(), sorted_buffers.end(), [](variable_buffer_header *first, variable_buffer_header *second) {
-            return first->tick_count > second->tick_count;
-        });
-        return sorted_buffers[1];
+    static std::optional<int32_t> copy_latest_buffer(const header *telemetry_header, const size_t &mapped_length, std::vector<std::byte> &destination) {
+        const auto num_buffers = std::min(telemetry_header->num_buffers, static_cast<int32_t>(std::size(telemetry_header->buffers)));
+        if (num_buffers <= 0 || destination.empty()) return std::nullopt;
+        for (int attempt = 0; attempt < 2; attempt++) {
+            int latest = 0;
+            for (int i = 1; i < num_buffers; i++) {
+                if (telemetry_header->buffers[i].tick_count > telemetry_header->buffers[latest].tick_count) latest = i;
+            }
+            const auto &buffer = telemetry_header->buffers[latest];
+            const auto tick_count = *reinterpret_cast<const volatile int32_t *>(&buffer.tick_count);
+            if (buffer.data_offset < 0 || static_cast<size_t>(buffer.data_offset) + destination.size() > mapped_length) return std::nullopt;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            memcpy(destination.data(), reinterpret_cast<const std::byte *>(telemetry_header) + buffer.data_offset, destination.size());
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (*reinterpret_cast<const volatile int32_t *>(&buffer.tick_count) == tick_count) return tick_count;
+        }
+        return std::nullopt;
     }
 
     static void process_lap_progress() {
@@ -127,95 +165,95 @@ namespace sc::iracing {
         }
     }
 
-    static void process_telemetry(header *telemetry_header, variable_header *variables) {
-        auto variable_buffer = find_recent_valid_buffer(telemetry_header);
-        for (int i = 0; i < telemetry_header->num_variables; i++) {
-            if (strcmp("RPM", reinterpret_cast<char *>(variables[i].name)) == 0) {
-                auto value = reinterpret_cast<float *>(reinterpret_cast<uintptr_t>(telemetry_header) + variable_buffer->data_offset + variables[i].offset);
-                spdlog::info("RPM: {}, {}", *value, variables[i].type);
-            } else if (strcmp("LapDistPct", reinterpret_cast<char *>(variables[i].name)) == 0) {
-                tele_lap_percent = *reinterpret_cast<float *>(reinterpret_cast<uintptr_t>(telemetry_header) + variable_buffer->data_offset + variables[i].offset);
-            } else if (strcmp("Speed", reinterpret_cast<char *>(variables[i].name)) == 0) {
-                tele_speed = *reinterpret_cast<float *>(reinterpret_cast<uintptr_t>(telemetry_header) + variable_buffer->data_offset + variables[i].offset);
-                tele_speed = tele_speed * 2.2f;
-            } else if (strcmp("Gear", reinterpret_cast<char *>(variables[i].name)) == 0) {
-                tele_gear = *reinterpret_cast<int *>(reinterpret_cast<uintptr_t>(telemetry_header) + variable_buffer->data_offset + variables[i].offset);
-            } else if (strcmp("LFshockDefl", reinterpret_cast<char *>(variables[i].name)) == 0) {
-                // spdlog::info("LFshockDefl: {}", *reinterpret_cast<float *>(reinterpret_cast<uintptr_t>(telemetry_header) + variable_buffer->data_offset + variables[i].offset));
-            } else if (strcmp("LFshockVel_ST", reinterpret_cast<char *>(variables[i].name)) == 0) {
-                spdlog::info("LFshockVel_ST: {}", *reinterpret_cast<float *>(reinterpret_cast<uintptr_t>(telemetry_header) + variable_buffer->data_offset + variables[i].offset));
-            }
+    static bool process_telemetry(const source &telemetry) {
+        if (telemetry.size() < sizeof(header)) return false;
+        const auto telemetry_header = reinterpret_cast<const header *>(telemetry.data());
+        if (const std::array<int32_t, 3> layout = { telemetry_header->num_variables, telemetry_header->variables_header_offset, telemetry_header->buffer_length }; layout != indexed_layout) {
+            if (layout[0] < 0 || layout[1] < 0 || static_cast<size_t>(layout[1]) + static_cast<size_t>(layout[0]) * sizeof(variable_header) > telemetry.size()) return false;
+            build_index(telemetry_header, reinterpret_cast<const variable_header *>(telemetry.data() + layout[1]));
+            indexed_layout = layout;
         }
+        const auto tick_count = copy_latest_buffer(telemetry_header, telemetry.size(), snapshot);
+        if (!tick_count || tick_count == snapshot_tick) return false;
+        snapshot_tick = tick_count;
+        const auto data = snapshot.data();
+        tele_lap_percent = resolved.lap_percent.read(data);
+        tele_rpm = resolved.rpm.read(data);
+        tele_speed = resolved.speed.read(data) * 2.2f;
+        tele_gear = resolved.gear.read(data);
+        publish_channels();
+        return true;
     }
 
     static void work() {
         DEFER(
             current_status = status::stopped;
         );
-        std::optional<std::chrono::system_clock::time_point> last_file_handle_open_attempt;
+        std::optional<std::chrono::system_clock::time_point> last_source_open_attempt;
         for (;;) {
             current_status = status::searching;
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
             if (!working) return;
-            if (!last_file_handle_open_attempt || std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - *last_file_handle_open_attempt).count() > 1) {
-                std::optional<HANDLE> file_handle;;
-                std::optional<std::byte *> mapped_file_buffer;
-                std::optional<HANDLE> event_handle;
+            if (!last_source_open_attempt || std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - *last_source_open_attempt).count() > 1) {
                 DEFER(
-                    if (event_handle) {
-                        CloseHandle(*event_handle);
-                        spdlog::debug("Closed iRacing event handle.");
-                        event_handle.reset();
-                    }
-                    if (mapped_file_buffer) {
-                        UnmapViewOfFile(*mapped_file_buffer);
-                        spdlog::debug("Unmapped iRacing memory file.");
-                        mapped_file_buffer.reset();
-                    }
-                    if (file_handle) {
-                        CloseHandle(*file_handle);
-                        spdlog::debug("Closed iRacing memory file handle.");
-                        file_handle.reset();
-                    }
-                    last_file_handle_open_attempt = std::chrono::system_clock::now();
+                    last_source_open_attempt = std::chrono::system_clock::now();
                 );
-                if (const auto attempted_handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mapped_file_name); attempted_handle) {
-                    file_handle = attempted_handle;
-                    if (const auto attempted_mapped_buffer = MapViewOfFile(*file_handle, FILE_MAP_ALL_ACCESS, 0, 0, mapped_file_length); attempted_mapped_buffer) {
-                        mapped_file_buffer = reinterpret_cast<std::byte *>(attempted_mapped_buffer);
-                        if (auto attempted_event_handle = OpenEventA(SYNCHRONIZE, FALSE, data_event_name); attempted_event_handle) {
-                            event_handle = attempted_event_handle;
-                            spdlog::debug("iRacing telemetry is online.");
-                            while (working) {
-                                const auto wait_res = WaitForSingleObject(*event_handle, 1000);
-                                if (wait_res == WAIT_OBJECT_0) {
-                                    current_status = status::live;
-                                    process_telemetry(
-                                        reinterpret_cast<header *>(*mapped_file_buffer),
-                                        reinterpret_cast<variable_header *>(reinterpret_cast<uintptr_t>(*mapped_file_buffer) + reinterpret_cast<header *>(*mapped_file_buffer)->variables_header_offset)
-                                    );
-                                    process_lap_progress();
-                                } else if (wait_res == WAIT_TIMEOUT) {
-                                    current_status = status::connected;
-                                } else if (wait_res == WAIT_ABANDONED) {
-                                    spdlog::warn("iRacing synchronization handle was abandoned.");
-                                    break;
-                                }
-                                else if (wait_res == WAIT_FAILED) {
-                                    spdlog::warn("iRacing synchronization handle returned fail state.");
-                                    break;
-                                }
-                            }
-                        } else spdlog::warn("Unable to open iRacing synchronization handle.");
-                    } else spdlog::warn("Unable to map iRacing memory file.");
+                const auto telemetry = open_source();
+                if (!telemetry) continue;
+                spdlog::debug("iRacing telemetry is online.");
+                indexed_layout.reset();
+                while (working) {
+                    const auto wait_res = telemetry->wait(std::chrono::milliseconds(1000));
+                    if (wait_res == wait_result::signaled) {
+                        current_status = status::live;
+                        if (process_telemetry(*telemetry)) process_lap_progress();
+                    } else if (wait_res == wait_result::timeout) {
+                        current_status = status::connected;
+                    } else break;
                 }
             }
         }
     }
 }
 
+void sc::iracing::attach(std::shared_ptr<channel> channel) {
+    const auto name = channel->name;
+    if (!pending_channels.try_push(std::move(channel))) spdlog::warn("Unable to subscribe to iRacing variable {}: too many pending subscriptions.", name);
+}
+
+std::shared_ptr<sc::iracing::channel> sc::iracing::subscribe(const std::string &name, const variable &layout, const size_t &capacity) {
+    std::shared_ptr<channel> result;
+    switch (layout.type) {
+        case variable_type::character:
+            result = std::make_shared<typed_channel<char>>(name, layout.count, capacity);
+            break;
+        case variable_type::boolean:
+            result = std::make_shared<typed_channel<bool>>(name, layout.count, capacity);
+            break;
+        case variable_type::integer:
+            result = std::make_shared<typed_channel<int32_t>>(name, layout.count, capacity);
+            break;
+        case variable_type::bitfield:
+            result = std::make_shared<typed_channel<uint32_t>>(name, layout.count, capacity);
+            break;
+        case variable_type::single:
+            result = std::make_shared<typed_channel<float>>(name, layout.count, capacity);
+            break;
+        case variable_type::dual:
+            result = std::make_shared<typed_channel<double>>(name, layout.count, capacity);
+            break;
+    }
+    attach(result);
+    return result;
+}
+
 void sc::iracing::startup() {
+    startup(create_system_source);
+}
+
+void sc::iracing::startup(source_factory factory) {
     shutdown();
+    open_source = std::move(factory);
     moments.resize(100000);
     spdlog::debug("Starting up iRacing telemetry worker.");
     working = true;
@@ -231,7 +269,19 @@ void sc::iracing::shutdown() {
     moments.clear();
 }
 
-const sc::iracing::status &sc::iracing::get_status() {
+std::map<std::string, int> sc::iracing::variables() {
+    std::lock_guard guard(tele_members_mutex);
+    return tele_members;
+}
+
+std::optional<sc::iracing::variable> sc::iracing::find(const std::string &name) {
+    std::lock_guard guard(tele_members_mutex);
+    const auto found = tele_layout.find(name);
+    if (found == tele_layout.end()) return std::nullopt;
+    return found->second;
+}
+
+sc::iracing::status sc::iracing::get_status() {
     return current_status;
 }
 
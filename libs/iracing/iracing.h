@@ -1,8 +1,20 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <atomic>
 #include <string>
+#include <optional>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+#include <algorithm>
+#include <unordered_map>
+
+#include "source.h"
+#include "../spsc_ring.hpp"
 
 namespace sc::iracing {
 
@@ -14,12 +26,184 @@ namespace sc::iracing {
         live
     };
 
+    enum class variable_type {
+
+        character,
+        boolean,
+        integer,
+        bitfield,
+        single,
+        dual
+    };
+
+    struct variable {
+
+        variable_type type;
+        int32_t offset;
+        int32_t count;
+    };
+
+    template<typename T>
+    constexpr variable_type type_of() {
+        if constexpr (std::is_same_v<T, float>) return variable_type::single;
+        else if constexpr (std::is_same_v<T, double>) return variable_type::dual;
+        else if constexpr (std::is_same_v<T, int32_t>) return variable_type::integer;
+        else if constexpr (std::is_same_v<T, uint32_t>) return variable_type::bitfield;
+        else if constexpr (std::is_same_v<T, bool>) return variable_type::boolean;
+        else {
+            static_assert(std::is_same_v<T, char>, "iRacing has no variables of this type");
+            return variable_type::character;
+        }
+    }
+
+    constexpr size_t size_of(const variable_type &type) {
+        switch (type) {
+            case variable_type::character:
+            case variable_type::boolean:
+                return 1;
+            case variable_type::dual:
+                return 8;
+            default:
+                return 4;
+        }
+    }
+
+    template<typename T>
+    struct accessor {
+
+        int32_t offset = -1;
+        int32_t count = 0;
+
+        bool valid() const {
+            return offset >= 0;
+        }
+
+        T read(const std::byte *buffer, const int32_t &element = 0, const T &fallback = T()) const {
+            if (offset < 0 || element < 0 || element >= count) return fallback;
+            T value;
+            memcpy(&value, buffer + offset + element * sizeof(T), sizeof(T));
+            return value;
+        }
+    };
+
+    struct variable_index {
+
+        std::unordered_map<std::string, variable> variables;
+
+        template<typename T>
+        accessor<T> resolve(const std::string &name) const {
+            const auto found = variables.find(name);
+            if (found == variables.end() || found->second.type != type_of<T>()) return { };
+            return { found->second.offset, found->second.count };
+        }
+    };
+
+    struct channel {
+
+        const std::string name;
+        const variable_type type;
+        const int32_t count;
+        std::atomic_bool attached = true;
+        std::atomic_bool resolved = false;
+        std::atomic<uint64_t> dropped = 0;
+        int32_t offset = -1, available = 0;
+
+        channel(const std::string &name, const variable_type &type, const int32_t &count) : name(name), type(type), count(count) {}
+        virtual ~channel() = default;
+
+        virtual void publish(const int32_t &tick, const std::byte *buffer) = 0;
+        virtual bool drain(int32_t &tick, std::byte *values) = 0;
+    };
+
+    template<typename T>
+    struct typed_channel : channel {
+
+        spsc_ring<T> ring;
+
+        typed_channel(const std::string &name, const int32_t &count, const size_t &capacity) : channel(name, type_of<T>(), count), ring(count, capacity) {}
+
+        void publish(const int32_t &tick, const std::byte *buffer) override {
+            const auto slot = ring.try_acquire();
+            if (!slot) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            memcpy(slot, buffer + offset, available * sizeof(T));
+            std::fill(slot + available, slot + count, T());
+            ring.commit(tick);
+        }
+
+        bool drain(int32_t &tick, std::byte *values) override {
+            int64_t stamp;
+            if (!ring.try_pop(stamp, reinterpret_cast<T *>(values))) return false;
+            tick = static_cast<int32_t>(stamp);
+            return true;
+        }
+    };
+
+    template<typename T>
+    class subscription {
+        public:
+            explicit subscription(std::shared_ptr<typed_channel<T>> channel) : channel_(std::move(channel)) {}
+            subscription(subscription &&) = default;
+            subscription &operator=(subscription &&other) {
+                if (this == &other) return *this;
+                if (channel_) channel_->attached = false;
+                channel_ = std::move(other.channel_);
+                return *this;
+            }
+            subscription(const subscription &) = delete;
+            subscription &operator=(const subscription &) = delete;
+
+            ~subscription() {
+                if (channel_) channel_->attached = false;
+            }
+
+            const std::string &name() const {
+                return channel_->name;
+            }
+
+            int32_t count() const {
+                return channel_->count;
+            }
+
+            bool resolved() const {
+                return channel_->resolved;
+            }
+
+            uint64_t dropped() const {
+                return channel_->dropped;
+            }
+
+            bool try_pop(int32_t &tick, T *values) {
+                int64_t stamp;
+                if (!channel_->ring.try_pop(stamp, values)) return false;
+                tick = static_cast<int32_t>(stamp);
+                return true;
+            }
+
+        private:
+            std::shared_ptr<typed_channel<T>> channel_;
+    };
+
+    void attach(std::shared_ptr<channel> channel);
+    std::shared_ptr<channel> subscribe(const std::string &name, const variable &layout, const size_t &capacity = 256);
+
+    template<typename T>
+    subscription<T> subscribe(const std::string &name, const int32_t &count = 1, const size_t &capacity = 256) {
+        auto channel = std::make_shared<typed_channel<T>>(name, std::max(count, 1), capacity);
+        attach(channel);
+        return subscription<T>(std::move(channel));
+    }
+
     void startup();
+    void startup(source_factory factory);
     void shutdown();
 
-    const status &get_status();
+    status get_status();
 
     std::map<std::string, int> variables();
+    std::optional<variable> find(const std::string &name);
 
     const std::atomic<bool> &prev();
     const std::atomic<float> &lap_percent();
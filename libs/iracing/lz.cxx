@@ -0,0 +1,101 @@
+#include "lz.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <algorithm>
+
+namespace sc::iracing::lz {
+
+    static constexpr size_t min_match = 4;
+    static constexpr size_t last_literals = 5;
+    static constexpr size_t match_search_limit = 12;
+    static constexpr size_t max_offset = 65535;
+    static constexpr int hash_bits = 12;
+
+    static uint32_t read_sequence(const std::byte *data) {
+        uint32_t value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    static uint32_t hash_sequence(const uint32_t &sequence) {
+        return (sequence * 2654435761u) >> (32 - hash_bits);
+    }
+
+    static void write_length(std::vector<std::byte> &output, size_t length) {
+        for (; length >= 255; length -= 255) output.push_back(std::byte(255));
+        output.push_back(static_cast<std::byte>(length));
+    }
+
+    static void write_sequence(std::vector<std::byte> &output, const std::byte *literals, const size_t &num_literals, const std::optional<std::pair<size_t, size_t>> &match) {
+        const auto match_length = match ? match->second - min_match : 0;
+        output.push_back(static_cast<std::byte>((std::min<size_t>(num_literals, 15) << 4) | std::min<size_t>(match_length, 15)));
+        if (num_literals >= 15) write_length(output, num_literals - 15);
+        output.insert(output.end(), literals, literals + num_literals);
+        if (!match) return;
+        output.push_back(static_cast<std::byte>(match->first & 0xff));
+        output.push_back(static_cast<std::byte>(match->first >> 8));
+        if (match_length >= 15) write_length(output, match_length - 15);
+    }
+
+    static std::optional<size_t> read_length(const std::byte *data, const size_t &size, size_t &position, size_t length) {
+        if (length != 15) return length;
+        for (;;) {
+            if (position >= size) return std::nullopt;
+            const auto extra = static_cast<size_t>(data[position++]);
+            length += extra;
+            if (extra != 255) return length;
+        }
+    }
+}
+
+std::vector<std::byte> sc::iracing::lz::compress(const std::byte *data, const size_t &size) {
+    std::vector<std::byte> output;
+    output.reserve(size + size / 255 + 16);
+    std::array<uint32_t, 1 << hash_bits> table = { 0 };
+    size_t anchor = 0;
+    const auto limit = size > match_search_limit ? size - match_search_limit : 0;
+    for (size_t i = 0; i < limit;) {
+        const auto sequence = read_sequence(data + i);
+        auto &entry = table[hash_sequence(sequence)];
+        const auto candidate = static_cast<size_t>(entry);
+        entry = static_cast<uint32_t>(i + 1);
+        if (candidate == 0 || i - (candidate - 1) > max_offset || read_sequence(data + candidate - 1) != sequence) {
+            i++;
+            continue;
+        }
+        const auto reference = candidate - 1;
+        auto length = min_match;
+        while (i + length < size - last_literals && data[reference + length] == data[i + length]) length++;
+        write_sequence(output, data + anchor, i - anchor, std::make_pair(i - reference, length));
+        i += length;
+        anchor = i;
+    }
+    write_sequence(output, data + anchor, size - anchor, std::nullopt);
+    return output;
+}
+
+tl::expected<std::vector<std::byte>, std::string> sc::iracing::lz::decompress(const std::byte *data, const size_t &size, const size_t &decompressed_size) {
+    std::vector<std::byte> output;
+    output.reserve(decompressed_size);
+    size_t position = 0;
+    while (position < size) {
+        const auto token = static_cast<size_t>(data[position++]);
+        const auto num_literals = read_length(data, size, position, token >> 4);
+        if (!num_literals || *num_literals > size - position || *num_literals > decompressed_size - output.size()) return tl::make_unexpected("Compressed block has invalid literals.");
+        output.insert(output.end(), data + position, data + position + *num_literals);
+        position += *num_literals;
+        if (position == size) break;
+        if (size - position < 2) return tl::make_unexpected("Compressed block is truncated.");
+        const auto offset = static_cast<size_t>(data[position]) | (static_cast<size_t>(data[position + 1]) << 8);
+        position += 2;
+        const auto length = read_length(data, size, position, token & 15);
+        if (!length || offset == 0 || offset > output.size() || *length + min_match > decompressed_size - output.size()) return tl::make_unexpected("Compressed block has an invalid match.");
+        const auto start = output.size() - offset;
+        for (size_t i = 0; i < *length + min_match; i++) output.push_back(output[start + i]);
+    }
+    if (output.size() != decompressed_size) return tl::make_unexpected("Compressed block has an unexpected size.");
+    return output;
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <string>
+
+#include <tl/expected.hpp>
+
+/*
+
+Byte oriented LZ77 codec that writes the LZ4 block format: a token with
+literal and match lengths, the literals, a little endian 16 bit offset
+and length extensions in runs of 255. Compression is a single greedy pass
+over a 4096 entry hash of 4 byte sequences, tuned for speed over ratio.
+
+*/
+
+namespace sc::iracing::lz {
+
+    std::vector<std::byte> compress(const std::byte *data, const size_t &size);
+    tl::expected<std::vector<std::byte>, std::string> decompress(const std::byte *data, const size_t &size, const size_t &decompressed_size);
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "source.h"
+
+#include <optional>
+
+#include <spdlog/spdlog.h>
+
+#include <windows.h>
+
+namespace sc::iracing {
+
+    static const auto mapped_file_name = "Local\\IRSDKMemMapFileName";
+    static const auto data_event_name = "Local\\IRSDKDataValidEvent";
+
+    struct mapping_source : source {
+
+        HANDLE file_handle = nullptr;
+        const std::byte *mapped_file_buffer = nullptr;
+        HANDLE event_handle = nullptr;
+
+        ~mapping_source() {
+            if (event_handle) {
+                CloseHandle(event_handle);
+                spdlog::debug("Closed iRacing event handle.");
+            }
+            if (mapped_file_buffer) {
+                UnmapViewOfFile(mapped_file_buffer);
+                spdlog::debug("Unmapped iRacing memory file.");
+            }
+            if (file_handle) {
+                CloseHandle(file_handle);
+                spdlog::debug("Closed iRacing memory file handle.");
+            }
+        }
+
+        const std::byte *data() const override {
+            return mapped_file_buffer;
+        }
+
+        size_t size() const override {
+            return mapped_file_length;
+        }
+
+        wait_result wait(const std::chrono::milliseconds &timeout) override {
+            const auto wait_res = WaitForSingleObject(event_handle, static_cast<DWORD>(timeout.count()));
+            if (wait_res == WAIT_OBJECT_0) return wait_result::signaled;
+            if (wait_res == WAIT_TIMEOUT) return wait_result::timeout;
+            if (wait_res == WAIT_ABANDONED) spdlog::warn("iRacing synchronization handle was abandoned.");
+            else spdlog::warn("iRacing synchronization handle returned fail state.");
+            return wait_result::failed;
+        }
+    };
+}
+
+std::unique_ptr<sc::iracing::source> sc::iracing::create_system_source() {
+    auto result = std::make_unique<mapping_source>();
+    result->file_handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, mapped_file_name);
+    if (!result->file_handle) return nullptr;
+    result->mapped_file_buffer = reinterpret_cast<const std::byte *>(MapViewOfFile(result->file_handle, FILE_MAP_ALL_ACCESS, 0, 0, mapped_file_length));
+    if (!result->mapped_file_buffer) {
+        spdlog::warn("Unable to map iRacing memory file.");
+        return nullptr;
+    }
+    result->event_handle = OpenEventA(SYNCHRONIZE, FALSE, data_event_name);
+    if (!result->event_handle) {
+        spdlog::warn("Unable to open iRacing synchronization handle.");
+        return nullptr;
+    }
+    return result;
+}
+
+std::unique_ptr<sc::iracing::source> sc::iracing::create_shared_memory_source(const std::string &, const int &) {
+    spdlog::warn("Shared memory telemetry sources are not supported on this platform.");
+    return nullptr;
+}
\ No newline at end of file
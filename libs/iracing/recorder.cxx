@@ -0,0 +1,269 @@
+#include "recorder.h"
+#include "lz.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+#include "../file/file.h"
+
+namespace sc::iracing {
+
+    struct recording_header {
+
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint32_t num_channels;
+        uint32_t reserved;
+    };
+
+    struct channel_entry {
+
+        int32_t type;
+        int32_t count;
+        std::array<char, 32> name;
+    };
+
+    struct block_header {
+
+        uint32_t channel;
+        uint32_t num_samples;
+        uint32_t raw_size;
+        uint32_t stored_size;
+    };
+
+    static_assert(sizeof(recording_header) == 16, "recording headers are written straight to disk");
+    static_assert(sizeof(channel_entry) == 40, "channel entries are written straight to disk");
+    static_assert(sizeof(block_header) == 16, "block headers are written straight to disk");
+
+    static size_t block_size(const variable_type &type, const int32_t &count, const size_t &num_samples) {
+        return num_samples * (sizeof(int32_t) + size_of(type) * count);
+    }
+
+    static void encode_column(const std::byte *source, const size_t &stride, const size_t &size, const size_t &num_samples, const bool &xor_delta, std::byte *destination) {
+        uint64_t previous = 0;
+        for (size_t i = 0; i < num_samples; i++) {
+            uint64_t word = 0;
+            memcpy(&word, source + i * stride, size);
+            const auto delta = xor_delta ? word ^ previous : word - previous;
+            previous = word;
+            for (size_t b = 0; b < size; b++) destination[b * num_samples + i] = static_cast<std::byte>(delta >> (b * 8));
+        }
+    }
+
+    static void decode_column(const std::byte *source, const size_t &stride, const size_t &size, const size_t &num_samples, const bool &xor_delta, std::byte *destination) {
+        uint64_t previous = 0;
+        for (size_t i = 0; i < num_samples; i++) {
+            uint64_t delta = 0;
+            for (size_t b = 0; b < size; b++) delta |= static_cast<uint64_t>(source[b * num_samples + i]) << (b * 8);
+            const auto word = xor_delta ? delta ^ previous : delta + previous;
+            previous = word;
+            memcpy(destination + i * stride, &word, size);
+        }
+    }
+
+    static bool uses_xor(const variable_type &type) {
+        return type == variable_type::single || type == variable_type::dual;
+    }
+}
+
+size_t sc::iracing::recorded_channel::width() const {
+    return size_of(type) * count;
+}
+
+const sc::iracing::recorded_channel *sc::iracing::recording::find(const std::string &name) const {
+    const auto found = std::find_if(channels.begin(), channels.end(), [&](const auto &channel) { return channel.name == name; });
+    return found == channels.end() ? nullptr : &*found;
+}
+
+tl::expected<sc::iracing::recording, std::string> sc::iracing::recording::load(const std::filesystem::path &path) {
+    const auto load_res = file::load(path);
+    if (!load_res.has_value()) return tl::make_unexpected(load_res.error());
+    const auto &data = *load_res;
+    recording_header header;
+    if (data.size() < sizeof(header)) return tl::make_unexpected("Recording is too short.");
+    memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != expected_magic || header.version != expected_version) return tl::make_unexpected("Recording has an unsupported format.");
+    if (header.num_channels > (data.size() - sizeof(header)) / sizeof(channel_entry)) return tl::make_unexpected("Recording has a truncated channel table.");
+    recording result;
+    size_t position = sizeof(header);
+    for (uint32_t i = 0; i < header.num_channels; i++) {
+        channel_entry entry;
+        memcpy(&entry, data.data() + position, sizeof(entry));
+        position += sizeof(entry);
+        if (entry.type < 0 || entry.type > static_cast<int32_t>(variable_type::dual) || entry.count <= 0) return tl::make_unexpected("Recording has an invalid channel.");
+        recorded_channel channel;
+        channel.name.assign(entry.name.data(), strnlen(entry.name.data(), entry.name.size()));
+        channel.type = static_cast<variable_type>(entry.type);
+        channel.count = entry.count;
+        result.channels.push_back(std::move(channel));
+    }
+    while (position < data.size()) {
+        block_header block;
+        if (data.size() - position < sizeof(block)) return tl::make_unexpected("Recording has a truncated block.");
+        memcpy(&block, data.data() + position, sizeof(block));
+        position += sizeof(block);
+        if (block.channel >= result.channels.size() || block.stored_size > data.size() - position || block.stored_size > block.raw_size) return tl::make_unexpected("Recording has an invalid block.");
+        auto &channel = result.channels[block.channel];
+        if (block.raw_size != block_size(channel.type, channel.count, block.num_samples)) return tl::make_unexpected("Recording has a block of unexpected size.");
+        std::vector<std::byte> raw;
+        if (block.stored_size < block.raw_size) {
+            auto decompress_res = lz::decompress(data.data() + position, block.stored_size, block.raw_size);
+            if (!decompress_res.has_value()) return tl::make_unexpected(decompress_res.error());
+            raw = std::move(*decompress_res);
+        } else raw.assign(data.data() + position, data.data() + position + block.raw_size);
+        position += block.stored_size;
+        const auto first = channel.ticks.size();
+        const auto size = size_of(channel.type);
+        channel.ticks.resize(first + block.num_samples);
+        channel.values.resize((first + block.num_samples) * channel.width());
+        decode_column(raw.data(), sizeof(int32_t), sizeof(int32_t), block.num_samples, false, reinterpret_cast<std::byte *>(channel.ticks.data() + first));
+        for (int32_t element = 0; element < channel.count; element++) {
+            const auto column = raw.data() + block.num_samples * (sizeof(int32_t) + element * size);
+            decode_column(column, channel.width(), size, block.num_samples, uses_xor(channel.type), channel.values.data() + first * channel.width() + element * size);
+        }
+    }
+    return result;
+}
+
+tl::expected<std::unique_ptr<sc::iracing::recording_writer>, std::string> sc::iracing::recording_writer::open(const std::filesystem::path &path, const std::vector<recorded_channel> &layout) {
+    std::unique_ptr<recording_writer> result(new recording_writer());
+    const recording_header header = { recording::expected_magic, recording::expected_version, static_cast<uint32_t>(layout.size()), 0 };
+    std::vector<channel_entry> entries;
+    for (const auto &channel : layout) {
+        channel_entry entry = { static_cast<int32_t>(channel.type), channel.count, { 0 } };
+        if (channel.name.size() >= entry.name.size()) return tl::make_unexpected("Channel name is too long: " + channel.name);
+        std::copy(channel.name.begin(), channel.name.end(), entry.name.begin());
+        entries.push_back(entry);
+        result->layout.emplace_back(channel.type, channel.count);
+    }
+    result->stream.open(path, std::ios::binary | std::ios::trunc);
+    if (!result->stream) return tl::make_unexpected("Unable to open file.");
+    result->stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    result->stream.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(channel_entry));
+    if (!result->stream) return tl::make_unexpected("Unable to write data.");
+    result->written = sizeof(header) + entries.size() * sizeof(channel_entry);
+    return result;
+}
+
+std::optional<std::string> sc::iracing::recording_writer::write(const size_t &channel_i, const int32_t *ticks, const std::byte *values, const size_t &num_samples) {
+    if (channel_i >= layout.size()) return "Channel does not exist.";
+    if (num_samples == 0) return std::nullopt;
+    const auto [type, count] = layout[channel_i];
+    const auto size = size_of(type);
+    const auto width = size * count;
+    columns.resize(block_size(type, count, num_samples));
+    encode_column(reinterpret_cast<const std::byte *>(ticks), sizeof(int32_t), sizeof(int32_t), num_samples, false, columns.data());
+    for (int32_t element = 0; element < count; element++) {
+        encode_column(values + element * size, width, size, num_samples, uses_xor(type), columns.data() + num_samples * (sizeof(int32_t) + element * size));
+    }
+    const auto compressed = lz::compress(columns.data(), columns.size());
+    const auto stored = compressed.size() < columns.size();
+    const block_header header = { static_cast<uint32_t>(channel_i), static_cast<uint32_t>(num_samples), static_cast<uint32_t>(columns.size()), static_cast<uint32_t>(stored ? compressed.size() : columns.size()) };
+    stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    stream.write(reinterpret_cast<const char *>(stored ? compressed.data() : columns.data()), header.stored_size);
+    stream.flush();
+    if (!stream) return "Unable to write data.";
+    written += sizeof(header) + header.stored_size;
+    return std::nullopt;
+}
+
+uint64_t sc::iracing::recording_writer::bytes_written() const {
+    return written;
+}
+
+sc::iracing::recorder::~recorder() {
+    stop();
+}
+
+tl::expected<std::unique_ptr<sc::iracing::recorder>, std::string> sc::iracing::recorder::start(const std::filesystem::path &path, const std::vector<std::string> &names, const size_t &block_samples) {
+    std::vector<recorded_channel> layout;
+    for (const auto &name : names) {
+        const auto found = iracing::find(name);
+        if (!found) return tl::make_unexpected("iRacing variable is not available: " + name);
+        recorded_channel channel;
+        channel.name = name;
+        channel.type = found->type;
+        channel.count = found->count;
+        layout.push_back(std::move(channel));
+    }
+    auto open_res = recording_writer::open(path, layout);
+    if (!open_res.has_value()) return tl::make_unexpected(open_res.error());
+    std::unique_ptr<recorder> result(new recorder());
+    result->writer = std::move(*open_res);
+    result->block_samples = std::max<size_t>(block_samples, 1);
+    for (const auto &channel : layout) {
+        pending target;
+        target.source = subscribe(channel.name, { channel.type, 0, channel.count }, 1024);
+        target.width = channel.width();
+        target.ticks.reserve(result->block_samples);
+        target.values.reserve(result->block_samples * target.width);
+        result->channels.push_back(std::move(target));
+    }
+    result->working = true;
+    result->worker = std::thread(&recorder::work, result.get());
+    spdlog::debug("Recording {} iRacing channels to {}.", layout.size(), path.string());
+    return result;
+}
+
+std::optional<std::string> sc::iracing::recorder::stop() {
+    working = false;
+    if (worker.joinable()) worker.join();
+    for (auto &target : channels) target.source->attached = false;
+    std::lock_guard guard(error_mutex);
+    return error;
+}
+
+uint64_t sc::iracing::recorder::samples() const {
+    return num_samples;
+}
+
+uint64_t sc::iracing::recorder::dropped() const {
+    uint64_t result = 0;
+    for (const auto &target : channels) result += target.source->dropped;
+    return result;
+}
+
+uint64_t sc::iracing::recorder::bytes_written() const {
+    return num_written;
+}
+
+void sc::iracing::recorder::work() {
+    while (working) {
+        if (!drain(false)) return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    drain(true);
+}
+
+bool sc::iracing::recorder::drain(const bool &flush) {
+    for (size_t i = 0; i < channels.size(); i++) {
+        auto &target = channels[i];
+        for (;;) {
+            const auto offset = target.values.size();
+            if (target.ticks.size() < block_samples) {
+                int32_t tick;
+                target.values.resize(offset + target.width);
+                if (target.source->drain(tick, target.values.data() + offset)) {
+                    target.ticks.push_back(tick);
+                    num_samples++;
+                    continue;
+                }
+                target.values.resize(offset);
+                if (!flush || target.ticks.empty()) break;
+            }
+            if (const auto err = writer->write(i, target.ticks.data(), target.values.data(), target.ticks.size()); err) {
+                spdlog::error("Unable to write iRacing recording: {}", *err);
+                std::lock_guard guard(error_mutex);
+                error = err;
+                return false;
+            }
+            num_written = writer->bytes_written();
+            target.ticks.clear();
+            target.values.clear();
+        }
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "iracing.h"
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tl/expected.hpp>
+
+/*
+
+Columnar telemetry recordings.
+
+A file starts with a header and a table of channels, followed by blocks
+that each hold a run of samples from one channel. Inside a block the
+ticks and every array element form their own column; each column is
+delta encoded (floating point values are XORed with their predecessor),
+split into byte planes so that the mostly zero high bytes sit together,
+and the whole block is LZ compressed. Blocks that do not shrink are
+stored as is.
+
+The recorder drains subscriptions on its own thread, so the telemetry
+worker only ever copies each tick into a ring, and memory stays bounded
+by the ring capacity plus one block per channel. 360 Hz _ST variables
+are arrays of six samples per tick and are recorded like any other array.
+
+*/
+
+namespace sc::iracing {
+
+    struct recorded_channel {
+
+        std::string name;
+        variable_type type = variable_type::single;
+        int32_t count = 1;
+        std::vector<int32_t> ticks;
+        std::vector<std::byte> values;
+
+        size_t width() const;
+
+        template<typename T>
+        T at(const size_t &sample, const int32_t &element = 0) const {
+            T value;
+            memcpy(&value, values.data() + sample * width() + element * sizeof(T), sizeof(T));
+            return value;
+        }
+    };
+
+    struct recording {
+
+        static constexpr std::array<char, 4> expected_magic = { 'S', 'C', 'I', 'T' };
+        static constexpr uint32_t expected_version = 1;
+
+        std::vector<recorded_channel> channels;
+
+        const recorded_channel *find(const std::string &name) const;
+
+        static tl::expected<recording, std::string> load(const std::filesystem::path &path);
+    };
+
+    struct recording_writer {
+
+        static tl::expected<std::unique_ptr<recording_writer>, std::string> open(const std::filesystem::path &path, const std::vector<recorded_channel> &layout);
+
+        std::optional<std::string> write(const size_t &channel_i, const int32_t *ticks, const std::byte *values, const size_t &num_samples);
+        uint64_t bytes_written() const;
+
+    private:
+
+        recording_writer() = default;
+
+        std::ofstream stream;
+        std::vector<std::pair<variable_type, int32_t>> layout;
+        std::vector<std::byte> columns;
+        uint64_t written = 0;
+    };
+
+    struct recorder {
+
+        static constexpr size_t default_block_samples = 4096;
+
+        recorder(const recorder &) = delete;
+        recorder &operator=(const recorder &) = delete;
+        ~recorder();
+
+        static tl::expected<std::unique_ptr<recorder>, std::string> start(const std::filesystem::path &path, const std::vector<std::string> &names, const size_t &block_samples = default_block_samples);
+
+        std::optional<std::string> stop();
+        uint64_t samples() const;
+        uint64_t dropped() const;
+        uint64_t bytes_written() const;
+
+    private:
+
+        struct pending {
+
+            std::shared_ptr<channel> source;
+            size_t width = 0;
+            std::vector<int32_t> ticks;
+            std::vector<std::byte> values;
+        };
+
+        recorder() = default;
+
+        void work();
+        bool drain(const bool &flush);
+
+        std::unique_ptr<recording_writer> writer;
+        std::vector<pending> channels;
+        size_t block_samples = default_block_samples;
+        std::thread worker;
+        std::atomic_bool working = false;
+        std::atomic<uint64_t> num_samples = 0;
+        std::atomic<uint64_t> num_written = 0;
+        std::mutex error_mutex;
+        std::optional<std::string> error;
+    };
+}
\ No newline at end of file
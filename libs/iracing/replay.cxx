@@ -0,0 +1,139 @@
+#include "replay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace sc::iracing {
+
+    static size_t align(const size_t &value, const size_t &alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+sc::iracing::replay::~replay() {
+    stop();
+    if (event >= 0) close(event);
+    if (mapped_file_buffer) munmap(mapped_file_buffer, mapped_file_length);
+    if (file >= 0) {
+        close(file);
+        shm_unlink(name.c_str());
+    }
+}
+
+tl::expected<std::unique_ptr<sc::iracing::replay>, std::string> sc::iracing::replay::open(std::shared_ptr<const recording> samples, const std::string &name) {
+    if (samples->channels.empty() || samples->channels.front().ticks.empty()) return tl::make_unexpected("Recording has no ticks to replay.");
+    std::unique_ptr<replay> result(new replay());
+    result->samples = std::move(samples);
+    result->name = name;
+    size_t buffer_length = 0;
+    for (const auto &channel : result->samples->channels) {
+        buffer_length = align(buffer_length, size_of(channel.type));
+        result->offsets.push_back(static_cast<int32_t>(buffer_length));
+        buffer_length += channel.width();
+    }
+    buffer_length = align(buffer_length, 16);
+    const auto num_variables = result->samples->channels.size();
+    const auto first_buffer_offset = align(sizeof(header) + num_variables * sizeof(variable_header), 16);
+    if (first_buffer_offset + buffer_length * num_buffers > mapped_file_length) return tl::make_unexpected("Recording does not fit into the telemetry memory file.");
+    result->cursors.assign(num_variables, 0);
+    result->buffer.assign(buffer_length, std::byte(0));
+    result->file = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+    if (result->file < 0) return tl::make_unexpected("Unable to create telemetry memory file: " + std::string(std::strerror(errno)));
+    if (ftruncate(result->file, mapped_file_length) != 0) return tl::make_unexpected("Unable to size telemetry memory file: " + std::string(std::strerror(errno)));
+    const auto mapped = mmap(nullptr, mapped_file_length, PROT_READ | PROT_WRITE, MAP_SHARED, result->file, 0);
+    if (mapped == MAP_FAILED) return tl::make_unexpected("Unable to map telemetry memory file: " + std::string(std::strerror(errno)));
+    result->mapped_file_buffer = reinterpret_cast<std::byte *>(mapped);
+    result->event = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (result->event < 0) return tl::make_unexpected("Unable to create telemetry event: " + std::string(std::strerror(errno)));
+    const auto variables = reinterpret_cast<variable_header *>(result->mapped_file_buffer + sizeof(header));
+    for (size_t i = 0; i < num_variables; i++) {
+        const auto &channel = result->samples->channels[i];
+        variables[i].type = static_cast<int32_t>(channel.type);
+        variables[i].offset = result->offsets[i];
+        variables[i].count = channel.count;
+        memcpy(variables[i].name, channel.name.data(), std::min(channel.name.size(), sizeof(variables[i].name) - 1));
+    }
+    const auto telemetry_header = reinterpret_cast<header *>(result->mapped_file_buffer);
+    telemetry_header->version = 2;
+    telemetry_header->status = 1;
+    telemetry_header->tick_rate = tick_rate;
+    telemetry_header->num_variables = static_cast<int32_t>(num_variables);
+    telemetry_header->variables_header_offset = sizeof(header);
+    telemetry_header->num_buffers = num_buffers;
+    telemetry_header->buffer_length = static_cast<int32_t>(buffer_length);
+    for (int32_t i = 0; i < num_buffers; i++) {
+        telemetry_header->buffers[i].tick_count = -1;
+        telemetry_header->buffers[i].data_offset = static_cast<int32_t>(first_buffer_offset + i * buffer_length);
+    }
+    return result;
+}
+
+void sc::iracing::replay::play(const double &speed) {
+    stop();
+    next = 0;
+    std::fill(cursors.begin(), cursors.end(), 0);
+    working = true;
+    worker = std::thread(&replay::work, this, speed);
+}
+
+void sc::iracing::replay::stop() {
+    working = false;
+    if (worker.joinable()) worker.join();
+}
+
+bool sc::iracing::replay::finished() const {
+    return next >= size();
+}
+
+size_t sc::iracing::replay::position() const {
+    return next;
+}
+
+size_t sc::iracing::replay::size() const {
+    return samples->channels.front().ticks.size();
+}
+
+sc::iracing::source_factory sc::iracing::replay::factory() const {
+    return [name = name, event = event] { return create_shared_memory_source(name, event); };
+}
+
+void sc::iracing::replay::work(const double &speed) {
+    const auto &ticks = samples->channels.front().ticks;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ticks.size() && working; i++) {
+        if (speed > 0) {
+            const std::chrono::duration<double> elapsed(static_cast<double>(ticks[i] - ticks.front()) / tick_rate / speed);
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(elapsed));
+        }
+        write(i);
+        next = i + 1;
+    }
+    spdlog::debug("Replayed {} of {} telemetry ticks.", next.load(), ticks.size());
+}
+
+void sc::iracing::replay::write(const size_t &tick_i) {
+    const auto tick = samples->channels.front().ticks[tick_i];
+    for (size_t i = 0; i < samples->channels.size(); i++) {
+        const auto &channel = samples->channels[i];
+        auto &cursor = cursors[i];
+        while (cursor + 1 < channel.ticks.size() && channel.ticks[cursor + 1] <= tick) cursor++;
+        if (cursor < channel.ticks.size() && channel.ticks[cursor] <= tick) memcpy(buffer.data() + offsets[i], channel.values.data() + cursor * channel.width(), channel.width());
+    }
+    const auto telemetry_header = reinterpret_cast<header *>(mapped_file_buffer);
+    auto &target = telemetry_header->buffers[tick_i % num_buffers];
+    *reinterpret_cast<volatile int32_t *>(&target.tick_count) = -1;
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(mapped_file_buffer + target.data_offset, buffer.data(), buffer.size());
+    std::atomic_thread_fence(std::memory_order_release);
+    *reinterpret_cast<volatile int32_t *>(&target.tick_count) = tick;
+    const uint64_t signal = 1;
+    if (::write(event, &signal, sizeof(signal)) != sizeof(signal)) spdlog::warn("Unable to signal telemetry event: {}", std::strerror(errno));
+}
\ No newline at end of file
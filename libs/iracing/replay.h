@@ -0,0 +1,74 @@
+#pragma once
+
+#include "recorder.h"
+#include "source.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tl/expected.hpp>
+
+/*
+
+Plays a recording back through a POSIX shared memory file laid out like
+the iRacing memory map, with an eventfd standing in for the data valid
+event. The first channel's ticks drive playback; other channels hold
+their last recorded value between their own ticks.
+
+Hand factory() to iracing::startup and the worker consumes the replay
+exactly like a live session, at real time or any multiple of it.
+
+~~~
+
+Examples:
+
+    auto session = sc::iracing::recording::load("session.scit");
+    auto player = sc::iracing::replay::open(std::make_shared<sc::iracing::recording>(std::move(*session)));
+    sc::iracing::startup((*player)->factory());
+    (*player)->play(4);
+
+*/
+
+namespace sc::iracing {
+
+    struct replay {
+
+        static constexpr int32_t tick_rate = 60;
+        static constexpr int32_t num_buffers = 3;
+
+        replay(const replay &) = delete;
+        replay &operator=(const replay &) = delete;
+        ~replay();
+
+        static tl::expected<std::unique_ptr<replay>, std::string> open(std::shared_ptr<const recording> samples, const std::string &name = "/sc-iracing-replay");
+
+        void play(const double &speed = 1);
+        void stop();
+        bool finished() const;
+        size_t position() const;
+        size_t size() const;
+        source_factory factory() const;
+
+    private:
+
+        replay() = default;
+
+        void work(const double &speed);
+        void write(const size_t &tick_i);
+
+        std::shared_ptr<const recording> samples;
+        std::string name;
+        int file = -1;
+        std::byte *mapped_file_buffer = nullptr;
+        int event = -1;
+        std::vector<int32_t> offsets;
+        std::vector<size_t> cursors;
+        std::vector<std::byte> buffer;
+        std::thread worker;
+        std::atomic_bool working = false;
+        std::atomic<size_t> next = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "source.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sc::iracing {
+
+    struct shared_memory_source : source {
+
+        int file = -1;
+        const std::byte *mapped_file_buffer = nullptr;
+        size_t length = 0;
+        int event = -1;
+
+        ~shared_memory_source() {
+            if (event >= 0) close(event);
+            if (mapped_file_buffer) munmap(const_cast<std::byte *>(mapped_file_buffer), length);
+            if (file >= 0) close(file);
+        }
+
+        const std::byte *data() const override {
+            return mapped_file_buffer;
+        }
+
+        size_t size() const override {
+            return length;
+        }
+
+        wait_result wait(const std::chrono::milliseconds &timeout) override {
+            pollfd target = { event, POLLIN, 0 };
+            const auto poll_res = poll(&target, 1, static_cast<int>(timeout.count()));
+            if (poll_res == 0 || (poll_res < 0 && errno == EINTR)) return wait_result::timeout;
+            if (poll_res < 0 || !(target.revents & POLLIN)) {
+                spdlog::warn("Telemetry event returned fail state.");
+                return wait_result::failed;
+            }
+            uint64_t signals;
+            if (read(event, &signals, sizeof(signals)) != sizeof(signals) && errno != EAGAIN) return wait_result::failed;
+            return wait_result::signaled;
+        }
+    };
+}
+
+std::unique_ptr<sc::iracing::source> sc::iracing::create_system_source() {
+    return nullptr;
+}
+
+std::unique_ptr<sc::iracing::source> sc::iracing::create_shared_memory_source(const std::string &name, const int &event) {
+    auto result = std::make_unique<shared_memory_source>();
+    result->file = shm_open(name.c_str(), O_RDONLY, 0);
+    if (result->file < 0) return nullptr;
+    struct stat status;
+    if (fstat(result->file, &status) != 0 || status.st_size <= 0) {
+        spdlog::warn("Unable to determine telemetry memory file size.");
+        return nullptr;
+    }
+    result->length = static_cast<size_t>(status.st_size);
+    const auto mapped = mmap(nullptr, result->length, PROT_READ, MAP_SHARED, result->file, 0);
+    if (mapped == MAP_FAILED) {
+        spdlog::warn("Unable to map telemetry memory file: {}", std::strerror(errno));
+        return nullptr;
+    }
+    result->mapped_file_buffer = reinterpret_cast<const std::byte *>(mapped);
+    result->event = fcntl(event, F_DUPFD_CLOEXEC, 0);
+    if (result->event < 0) {
+        spdlog::warn("Unable to open telemetry event: {}", std::strerror(errno));
+        return nullptr;
+    }
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace sc::iracing {
+
+    static constexpr size_t mapped_file_length = 1164 * 1024;
+
+    struct variable_buffer_header {
+
+        int32_t tick_count;
+        int32_t data_offset;
+        uint32_t _padding_1[2];
+    };
+
+    struct header {
+
+        int32_t version;
+        int32_t status;
+        int32_t tick_rate;
+        int32_t session_info_update;
+        int32_t session_info_length;
+        int32_t session_info_offset;
+        int32_t num_variables;
+        int32_t variables_header_offset;
+        int32_t num_buffers;
+        int32_t buffer_length;
+        uint32_t _padding_1[2];
+        variable_buffer_header buffers[4];
+    };
+
+    struct variable_header {
+
+        int32_t type;
+        int32_t offset;
+        int32_t count;
+        std::byte count_as_time;
+        uint8_t _padding_1[3];
+        std::byte name[32];
+        std::byte description[64];
+        std::byte unit[32];
+    };
+
+    enum class wait_result {
+
+        signaled,
+        timeout,
+        failed
+    };
+
+    struct source {
+
+        virtual ~source() = default;
+
+        virtual const std::byte *data() const = 0;
+        virtual size_t size() const = 0;
+        virtual wait_result wait(const std::chrono::milliseconds &timeout) = 0;
+    };
+
+    using source_factory = std::function<std::unique_ptr<source>()>;
+
+    std::unique_ptr<source> create_system_source();
+    std::unique_ptr<source> create_shared_memory_source(const std::string &name, const int &event);
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include <spdlog/spdlog.h>
+
+#include "lz.h"
+#include "recorder.h"
+
+#include <cmath>
+#include <random>
+
+namespace sl = spdlog;
+
+static bool round_trip(const std::vector<std::byte> &data) {
+    const auto compressed = sc::iracing::lz::compress(data.data(), data.size());
+    const auto decompressed = sc::iracing::lz::decompress(compressed.data(), compressed.size(), data.size());
+    return decompressed.has_value() && *decompressed == data;
+}
+
+int main() {
+    std::mt19937 random(7);
+    for (const size_t size : { 0, 1, 5, 12, 13, 64, 1000, 70000, 300000 }) {
+        std::vector<std::byte> noise(size), runs(size), text(size);
+        for (size_t i = 0; i < size; i++) {
+            noise[i] = static_cast<std::byte>(random());
+            runs[i] = static_cast<std::byte>(i / 300);
+            text[i] = static_cast<std::byte>("telemetry "[i % 10] + (i % 997 == 0));
+        }
+        if (!round_trip(noise) || !round_trip(runs) || !round_trip(text)) {
+            sl::error("Compression does not round trip {} bytes.", size);
+            return 1;
+        }
+    }
+    const std::vector<std::byte> garbage = { std::byte(0xf0), std::byte(1), std::byte(2) };
+    if (sc::iracing::lz::decompress(garbage.data(), garbage.size(), 64).has_value()) {
+        sl::error("Decompression accepts a truncated block.");
+        return 1;
+    }
+
+    const auto path = std::filesystem::temp_directory_path() / "test_recorder.scit";
+    std::vector<sc::iracing::recorded_channel> layout(3);
+    layout[0].name = "RPM";
+    layout[0].type = sc::iracing::variable_type::single;
+    layout[1].name = "Gear";
+    layout[1].type = sc::iracing::variable_type::integer;
+    layout[2].name = "LatAccel_ST";
+    layout[2].type = sc::iracing::variable_type::single;
+    layout[2].count = 6;
+    const size_t num_ticks = 10000, block_samples = 4096;
+    std::vector<int32_t> ticks(num_ticks);
+    std::vector<float> rpm(num_ticks), accel(num_ticks * 6);
+    std::vector<int32_t> gear(num_ticks);
+    for (size_t i = 0; i < num_ticks; i++) {
+        ticks[i] = static_cast<int32_t>(1000 + i + (i == 5000 ? 3 : 0));
+        rpm[i] = 4000.f + 3000.f * std::sin(static_cast<float>(i) / 200.f);
+        gear[i] = static_cast<int32_t>(i / 1500) % 6 + 1;
+        for (size_t j = 0; j < 6; j++) accel[i * 6 + j] = std::cos(static_cast<float>(i * 6 + j) / 360.f) * 9.81f;
+    }
+    {
+        auto writer = sc::iracing::recording_writer::open(path, layout);
+        if (!writer.has_value()) {
+            sl::error("Unable to open recording: {}", writer.error());
+            return 1;
+        }
+        for (size_t first = 0; first < num_ticks; first += block_samples) {
+            const auto count = std::min(block_samples, num_ticks - first);
+            const auto values = [&](const auto &source, const size_t &width) { return reinterpret_cast<const std::byte *>(source.data() + first * width); };
+            auto err = (*writer)->write(0, ticks.data() + first, values(rpm, 1), count);
+            if (!err) err = (*writer)->write(1, ticks.data() + first, values(gear, 1), count);
+            if (!err) err = (*writer)->write(2, ticks.data() + first, values(accel, 6), count);
+            if (err) {
+                sl::error("Unable to write recording: {}", *err);
+                return 1;
+            }
+        }
+        const auto raw = num_ticks * (4 + 4) * 2 + num_ticks * (4 + 24);
+        sl::info("Recorded {} bytes of telemetry into {} bytes.", raw, (*writer)->bytes_written());
+        if ((*writer)->bytes_written() * 2 > raw) {
+            sl::error("Recording does not compress smooth telemetry.");
+            return 1;
+        }
+    }
+    const auto loaded = sc::iracing::recording::load(path);
+    std::filesystem::remove(path);
+    if (!loaded.has_value()) {
+        sl::error("Unable to load recording: {}", loaded.error());
+        return 1;
+    }
+    const auto loaded_rpm = loaded->find("RPM");
+    const auto loaded_gear = loaded->find("Gear");
+    const auto loaded_accel = loaded->find("LatAccel_ST");
+    if (!loaded_rpm || !loaded_gear || !loaded_accel || loaded_accel->count != 6 || loaded_rpm->ticks != ticks || loaded_accel->ticks != ticks) {
+        sl::error("Recording does not restore its channels.");
+        return 1;
+    }
+    for (size_t i = 0; i < num_ticks; i++) {
+        bool matches = loaded_rpm->at<float>(i) == rpm[i] && loaded_gear->at<int32_t>(i) == gear[i];
+        for (int32_t j = 0; j < 6; j++) matches = matches && loaded_accel->at<float>(i, j) == accel[i * 6 + j];
+        if (!matches) {
+            sl::error("Recording does not restore sample {}.", i);
+            return 1;
+        }
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include <spdlog/spdlog.h>
+
+#include "iracing.h"
+#include "replay.h"
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace sl = spdlog;
+
+int main() {
+    auto session = std::make_shared<sc::iracing::recording>();
+    session->channels.resize(3);
+    auto &rpm = session->channels[0];
+    rpm.name = "RPM";
+    rpm.type = sc::iracing::variable_type::single;
+    auto &gear = session->channels[1];
+    gear.name = "Gear";
+    gear.type = sc::iracing::variable_type::integer;
+    auto &accel = session->channels[2];
+    accel.name = "LatAccel_ST";
+    accel.type = sc::iracing::variable_type::single;
+    accel.count = 6;
+    const int32_t num_ticks = 1200;
+    for (int32_t tick = 0; tick < num_ticks; tick++) {
+        const auto value = 4000.f + static_cast<float>(tick);
+        rpm.ticks.push_back(tick);
+        rpm.values.insert(rpm.values.end(), reinterpret_cast<const std::byte *>(&value), reinterpret_cast<const std::byte *>(&value) + sizeof(value));
+        if (tick % 100 == 0) {
+            const int32_t current = tick / 100;
+            gear.ticks.push_back(tick);
+            gear.values.insert(gear.values.end(), reinterpret_cast<const std::byte *>(&current), reinterpret_cast<const std::byte *>(&current) + sizeof(current));
+        }
+        accel.ticks.push_back(tick);
+        for (int32_t j = 0; j < 6; j++) {
+            const auto sample = static_cast<float>(tick * 6 + j);
+            accel.values.insert(accel.values.end(), reinterpret_cast<const std::byte *>(&sample), reinterpret_cast<const std::byte *>(&sample) + sizeof(sample));
+        }
+    }
+    auto player = sc::iracing::replay::open(session, "/sc-test-replay");
+    if (!player.has_value()) {
+        sl::error("Unable to open replay: {}", player.error());
+        return 1;
+    }
+    auto rpm_subscription = sc::iracing::subscribe<float>("RPM");
+    auto gear_subscription = sc::iracing::subscribe<int32_t>("Gear");
+    auto accel_subscription = sc::iracing::subscribe<float>("LatAccel_ST", 6, 2048);
+    sc::iracing::startup((*player)->factory());
+    (*player)->play(10);
+    size_t received = 0;
+    int32_t last_tick = -1;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!(*player)->finished() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        int32_t tick, current_gear;
+        float value;
+        std::array<float, 6> samples;
+        while (rpm_subscription.try_pop(tick, &value)) {
+            if (tick <= last_tick || value != 4000.f + static_cast<float>(tick)) {
+                sl::error("Replayed RPM does not match the recording at tick {}.", tick);
+                return 1;
+            }
+            last_tick = tick;
+            received++;
+        }
+        while (gear_subscription.try_pop(tick, &current_gear)) {
+            if (current_gear != tick / 100) {
+                sl::error("Replayed gear is not held between recorded ticks at tick {}.", tick);
+                return 1;
+            }
+        }
+        while (accel_subscription.try_pop(tick, samples.data())) {
+            for (int32_t j = 0; j < 6; j++) {
+                if (samples[j] != static_cast<float>(tick * 6 + j)) {
+                    sl::error("Replayed array does not match the recording at tick {}.", tick);
+                    return 1;
+                }
+            }
+        }
+    }
+    const auto status = sc::iracing::get_status();
+    const auto layout = sc::iracing::find("LatAccel_ST");
+    sc::iracing::shutdown();
+    sl::info("Received {} of {} replayed ticks.", received, num_ticks);
+    if (!(*player)->finished() || status != sc::iracing::status::live) {
+        sl::error("Replay did not run to completion.");
+        return 1;
+    }
+    if (!layout || layout->count != 6 || !accel_subscription.resolved()) {
+        sl::error("Replay does not publish the recorded variable layout.");
+        return 1;
+    }
+    if (received < num_ticks / 2) {
+        sl::error("Telemetry worker missed too many replayed ticks.");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
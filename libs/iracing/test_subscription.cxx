@@ -0,0 +1,97 @@
+#include <spdlog/spdlog.h>
+
+#include "iracing.h"
+
+#include <array>
+#include <thread>
+
+namespace sl = spdlog;
+
+int main() {
+    sc::spsc_ring<float> ring(3, 5);
+    if (ring.capacity() != 8 || ring.width() != 3) {
+        sl::error("Ring does not round its capacity up to a power of two.");
+        return 1;
+    }
+    for (int i = 0; i < 8; i++) {
+        const auto slot = ring.try_acquire();
+        if (!slot) {
+            sl::error("Ring refuses a write before it is full.");
+            return 1;
+        }
+        slot[0] = static_cast<float>(i);
+        ring.commit(i);
+    }
+    if (ring.try_acquire() || ring.size() != 8) {
+        sl::error("Ring accepts a write when it is full.");
+        return 1;
+    }
+    int64_t stamp;
+    std::array<float, 3> values;
+    while (ring.try_pop(stamp, values.data()));
+    constexpr int num_samples = 100000;
+    std::thread producer([&] {
+        for (int i = 0; i < num_samples;) {
+            if (const auto slot = ring.try_acquire(); slot) {
+                slot[0] = static_cast<float>(i);
+                slot[1] = static_cast<float>(i + 1);
+                slot[2] = static_cast<float>(i + 2);
+                ring.commit(i++);
+            } else std::this_thread::yield();
+        }
+    });
+    for (int i = 0; i < num_samples;) {
+        if (!ring.try_pop(stamp, values.data())) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (stamp != i || values[0] != static_cast<float>(i) || values[2] != static_cast<float>(i + 2)) {
+            producer.join();
+            sl::error("Ring delivers sample #{} out of order or torn.", i);
+            return 1;
+        }
+        i++;
+    }
+    producer.join();
+
+    auto channel = std::make_shared<sc::iracing::typed_channel<int32_t>>("CarIdxGear", 4, 2);
+    channel->offset = 4;
+    channel->available = 2;
+    const std::array<int32_t, 4> buffer = { 9, 3, 4, 7 };
+    for (int32_t tick = 1; tick <= 3; tick++) channel->publish(tick, reinterpret_cast<const std::byte *>(buffer.data()));
+    if (channel->dropped != 1) {
+        sl::error("Channel does not count samples dropped by a full ring.");
+        return 1;
+    }
+    sc::iracing::subscription<int32_t> first(channel);
+    int32_t tick;
+    std::array<int32_t, 4> gears;
+    if (!first.try_pop(tick, gears.data()) || tick != 1 || gears != std::array<int32_t, 4> { 3, 4, 0, 0 }) {
+        sl::error("Channel does not copy its variable or zero the missing elements.");
+        return 1;
+    }
+    auto second = sc::iracing::subscribe<float>("RPM");
+    if (second.resolved() || second.count() != 1 || !channel->attached) {
+        sl::error("Subscription starts in an unexpected state.");
+        return 1;
+    }
+    auto moved = std::move(first);
+    if (!channel->attached || moved.name() != "CarIdxGear") {
+        sl::error("Moving a subscription detaches its channel.");
+        return 1;
+    }
+    auto replacement = std::make_shared<sc::iracing::typed_channel<int32_t>>("Gear", 1, 2);
+    moved = sc::iracing::subscription<int32_t>(replacement);
+    if (channel->attached || !replacement->attached || moved.name() != "Gear") {
+        sl::error("Assigning over a subscription does not detach its old channel.");
+        return 1;
+    }
+    {
+        auto scoped = std::move(moved);
+    }
+    if (replacement->attached) {
+        sl::error("Destroying a subscription does not detach its channel.");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
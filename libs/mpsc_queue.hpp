@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+/*
+
+Bounded, lock-free queue for many producers and a single consumer.
+
+Each slot carries a sequence number that tells producers whether it is
+free and tells the consumer whether it has been filled, so neither side
+ever waits on a lock. Pushing to a full queue fails instead of blocking.
+
+Based on Dmitry Vyukov's bounded MPMC queue:
+https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+
+~~~
+
+Examples:
+
+    static sc::mpsc_queue<command, 64> commands;
+
+    // Any thread.
+    if (!commands.try_push(cmd)) spdlog::warn("Command queue is full.");
+
+    // Owning thread only.
+    while (auto cmd = commands.try_pop()) apply(*cmd);
+
+*/
+
+namespace sc {
+
+    template<typename T, size_t capacity>
+    class mpsc_queue {
+        static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0, "mpsc_queue capacity must be a power of two");
+        public:
+            mpsc_queue() {
+                for (size_t i = 0; i < capacity; i++) cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            ~mpsc_queue() {
+                while (try_pop());
+            }
+
+            mpsc_queue(const mpsc_queue &) = delete;
+            mpsc_queue &operator=(const mpsc_queue &) = delete;
+
+            template<typename U>
+            bool try_push(U &&value) {
+                auto position = tail_.load(std::memory_order_relaxed);
+                for (;;) {
+                    auto &cell = cells_[position & (capacity - 1)];
+                    const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                    const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+                    if (difference == 0) {
+                        if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                            new (&cell.storage) T(std::forward<U>(value));
+                            cell.sequence.store(position + 1, std::memory_order_release);
+                            return true;
+                        }
+                    } else if (difference < 0) return false;
+                    else position = tail_.load(std::memory_order_relaxed);
+                }
+            }
+
+            std::optional<T> try_pop() {
+                auto &cell = cells_[head_ & (capacity - 1)];
+                if (cell.sequence.load(std::memory_order_acquire) != head_ + 1) return std::nullopt;
+                auto element = reinterpret_cast<T *>(&cell.storage);
+                std::optional<T> value = std::move(*element);
+                element->~T();
+                cell.sequence.store(head_ + capacity, std::memory_order_release);
+                head_++;
+                return value;
+            }
+
+            bool empty() const {
+                return cells_[head_ & (capacity - 1)].sequence.load(std::memory_order_acquire) != head_ + 1;
+            }
+
+        private:
+            struct cell {
+                std::atomic<size_t> sequence;
+                std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+            };
+
+            std::array<cell, capacity> cells_;
+            alignas(64) std::atomic<size_t> tail_ = 0;
+            alignas(64) size_t head_ = 0;
+    };
+}
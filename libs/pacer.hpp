@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#else
+#include <ctime>
+#include <cerrno>
+#endif
+
+/*
+
+Waits for fixed-rate deadlines without burning a core.
+
+The thread sleeps on a high-resolution timer until shortly before the
+deadline and only spins for the remaining tail, which absorbs the wake
+up latency of the timer. Sleeping through std::this_thread alone rounds
+up to the scheduler tick, which is as long as a whole 1 kHz period.
+
+~~~
+
+Examples:
+
+    sc::pacer pacer;
+    auto next_tick = sc::pacer::clock::now();
+    while (working) {
+        tick();
+        next_tick += period;
+        pacer.wait_until(next_tick);
+    }
+
+*/
+
+namespace sc {
+
+    class pacer {
+        public:
+            using clock = std::chrono::steady_clock;
+
+            explicit pacer(const clock::duration &tail = std::chrono::microseconds(150)) : tail_(tail) {
+#ifdef _WIN32
+                timer_ = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+                if (!timer_) timer_ = CreateWaitableTimerW(nullptr, TRUE, nullptr);
+#endif
+            }
+
+            pacer(const pacer &) = delete;
+            pacer &operator=(const pacer &) = delete;
+
+            ~pacer() {
+#ifdef _WIN32
+                if (timer_) CloseHandle(timer_);
+#endif
+            }
+
+            void wait_until(const clock::time_point &deadline) const {
+                if (const auto wake = deadline - tail_; wake > clock::now()) sleep_until(wake);
+                while (clock::now() < deadline) std::this_thread::yield();
+            }
+
+        private:
+            clock::duration tail_;
+#ifdef _WIN32
+            HANDLE timer_ = nullptr;
+
+            void sleep_until(const clock::time_point &wake) const {
+                const auto remaining = std::chrono::duration_cast<std::chrono::duration<LONGLONG, std::ratio<1, 10000000>>>(wake - clock::now()).count();
+                if (remaining <= 0) return;
+                LARGE_INTEGER due;
+                due.QuadPart = -remaining;
+                if (timer_ && SetWaitableTimer(timer_, &due, 0, nullptr, nullptr, FALSE)) WaitForSingleObject(timer_, INFINITE);
+                else std::this_thread::sleep_until(wake);
+            }
+#else
+            void sleep_until(const clock::time_point &wake) const {
+                const auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(wake.time_since_epoch()).count();
+                timespec due;
+                due.tv_sec = static_cast<time_t>(since_epoch / 1000000000);
+                due.tv_nsec = static_cast<long>(since_epoch % 1000000000);
+                while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, nullptr) == EINTR);
+            }
+#endif
+    };
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "autorange.h"
+
+#include <algorithm>
+#include <cmath>
+
+sc::pedals::p2_quantile::p2_quantile(const double &quantile) : quantile(std::clamp(quantile, 0.0, 1.0)) {
+    reset();
+}
+
+void sc::pedals::p2_quantile::reset() {
+    num_samples = 0;
+    heights.fill(0);
+    positions = { 1, 2, 3, 4, 5 };
+    desired = { 1, 1 + 2 * quantile, 1 + 4 * quantile, 3 + 2 * quantile, 5 };
+    increments = { 0, quantile / 2, quantile, (1 + quantile) / 2, 1 };
+}
+
+void sc::pedals::p2_quantile::record(const double &value) {
+    if (num_samples < heights.size()) {
+        heights[num_samples++] = value;
+        if (num_samples == heights.size()) std::sort(heights.begin(), heights.end());
+        return;
+    }
+    num_samples++;
+    size_t cell;
+    if (value < heights[0]) {
+        heights[0] = value;
+        cell = 0;
+    } else if (value >= heights[4]) {
+        heights[4] = value;
+        cell = 3;
+    } else {
+        cell = 0;
+        while (cell < 3 && value >= heights[cell + 1]) cell++;
+    }
+    for (size_t i = cell + 1; i < positions.size(); i++) positions[i]++;
+    for (size_t i = 0; i < desired.size(); i++) desired[i] += increments[i];
+    for (size_t i = 1; i < 4; i++) {
+        const auto offset = desired[i] - positions[i];
+        if ((offset >= 1 && positions[i + 1] - positions[i] > 1) || (offset <= -1 && positions[i - 1] - positions[i] < -1)) {
+            const auto direction = offset >= 0 ? 1.0 : -1.0;
+            const auto parabolic = heights[i] + direction / (positions[i + 1] - positions[i - 1]) * (
+                (positions[i] - positions[i - 1] + direction) * (heights[i + 1] - heights[i]) / (positions[i + 1] - positions[i]) +
+                (positions[i + 1] - positions[i] - direction) * (heights[i] - heights[i - 1]) / (positions[i] - positions[i - 1])
+            );
+            if (heights[i - 1] < parabolic && parabolic < heights[i + 1]) heights[i] = parabolic;
+            else {
+                const auto neighbour = static_cast<size_t>(static_cast<double>(i) + direction);
+                heights[i] += direction * (heights[neighbour] - heights[i]) / (positions[neighbour] - positions[i]);
+            }
+            positions[i] += direction;
+        }
+    }
+}
+
+uint64_t sc::pedals::p2_quantile::count() const {
+    return num_samples;
+}
+
+double sc::pedals::p2_quantile::estimate() const {
+    if (num_samples == 0) return 0;
+    if (num_samples < heights.size()) {
+        auto sorted = heights;
+        std::sort(sorted.begin(), sorted.begin() + num_samples);
+        return sorted[std::min(static_cast<size_t>(quantile * static_cast<double>(num_samples)), static_cast<size_t>(num_samples - 1))];
+    }
+    return heights[2];
+}
+
+sc::pedals::auto_range::auto_range(const double &low_quantile, const double &high_quantile) : low(low_quantile), high(high_quantile) {
+
+}
+
+void sc::pedals::auto_range::reset() {
+    low.reset();
+    high.reset();
+    observed_min = 1;
+    observed_max = 0;
+}
+
+void sc::pedals::auto_range::record(const float &input) {
+    observed_min = std::min(observed_min, input);
+    observed_max = std::max(observed_max, input);
+    low.record(input);
+    const auto span = observed_max - observed_min;
+    if (span > .05f && input > static_cast<float>(low.estimate()) + span * .1f) high.record(input);
+}
+
+sc::pedals::auto_range::estimate sc::pedals::auto_range::current() const {
+    estimate result;
+    if (low.count() < min_samples || high.count() < min_samples / 10) return result;
+    result.min = std::clamp(static_cast<float>(low.estimate()), 0.f, 1.f);
+    result.max = std::clamp(std::min(static_cast<float>(high.estimate()), observed_max), 0.f, 1.f);
+    result.ready = result.max > result.min;
+    return result;
+}
\ No newline at end of file
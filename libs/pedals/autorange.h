@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/*
+
+Constant-memory range tracking for an axis.
+
+p2_quantile is the P-square estimator of Jain and Chlamtac: five markers
+whose heights are nudged towards the target quantile with a parabolic
+update, so each sample costs the same however long the session runs.
+
+auto_range feeds every sample into a low quantile estimator to find the
+resting position, and only samples clearly above rest into a high quantile
+estimator to find the fully pressed position. A pedal spends most of its
+time at rest, so a plain high quantile over all samples would never reach
+full travel.
+
+*/
+
+namespace sc::pedals {
+
+    struct p2_quantile {
+
+        explicit p2_quantile(const double &quantile = .5);
+
+        void reset();
+        void record(const double &value);
+        uint64_t count() const;
+        double estimate() const;
+
+    private:
+
+        double quantile;
+        uint64_t num_samples = 0;
+        std::array<double, 5> heights = { 0 };
+        std::array<double, 5> positions = { 0 };
+        std::array<double, 5> desired = { 0 };
+        std::array<double, 5> increments = { 0 };
+    };
+
+    struct auto_range {
+
+        static constexpr uint64_t min_samples = 2000;
+
+        struct estimate {
+
+            bool ready = false;
+            float min = 0, max = 1;
+        };
+
+        auto_range(const double &low_quantile = .01, const double &high_quantile = .98);
+
+        void reset();
+        void record(const float &input);
+        estimate current() const;
+
+    private:
+
+        p2_quantile low, high;
+        float observed_min = 1, observed_max = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "batch.h"
+
+#include <glm/common.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SC_PEDALS_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifndef SC_PEDALS_SSE2
+namespace sc::pedals {
+
+    static float lookup(const transfer_lut &curve, const float &position) {
+        const auto index = glm::min(static_cast<size_t>(position), transfer_lut::resolution - 1);
+        const auto fraction = position - static_cast<float>(index);
+        return curve.table[index] + (curve.table[index + 1] - curve.table[index]) * fraction;
+    }
+}
+#endif
+
+sc::pedals::axis_batch::axis_batch() {
+    for (size_t lane = 0; lane < lanes; lane++) configure(lane, { });
+}
+
+void sc::pedals::axis_batch::configure(const size_t &lane, const transfer_settings &settings) {
+    if (lane >= lanes) return;
+    const auto max_input = settings.range_max;
+    auto min_input = settings.range_min + (settings.range_max - settings.range_min) * settings.deadzone;
+    if (min_input > max_input) min_input = max_input;
+    input_min[lane] = min_input;
+    input_scale[lane] = max_input > min_input ? 1.f / (max_input - min_input) : 1e30f;
+    limit[lane] = settings.limit;
+    transfer_settings curve_only;
+    curve_only.curve_type = settings.curve_type;
+    curve_only.curve = settings.curve;
+    curves[lane] = transfer_lut::compile(curve_only);
+}
+
+void sc::pedals::axis_batch::process(const float *inputs, float *outputs, uint8_t *reports, const size_t &num_frames) const {
+#ifdef SC_PEDALS_SSE2
+    const auto v_min = _mm_load_ps(input_min.data());
+    const auto v_scale = _mm_load_ps(input_scale.data());
+    const auto v_limit = _mm_load_ps(limit.data());
+    const auto v_zero = _mm_setzero_ps();
+    const auto v_one = _mm_set1_ps(1.f);
+    const auto v_resolution = _mm_set1_ps(static_cast<float>(transfer_lut::resolution));
+    const auto v_last_index = _mm_set1_epi32(static_cast<int>(transfer_lut::resolution - 1));
+    const auto v_report_scale = _mm_set1_ps(128.f);
+    const auto v_report_bias = _mm_set1_ps(127.5f);
+    for (size_t frame_i = 0; frame_i < num_frames; frame_i++) {
+        auto value = _mm_loadu_ps(inputs + frame_i * lanes);
+        value = _mm_mul_ps(_mm_sub_ps(value, v_min), v_scale);
+        value = _mm_min_ps(_mm_max_ps(value, v_zero), v_one);
+        const auto position = _mm_mul_ps(value, v_resolution);
+        auto index = _mm_cvttps_epi32(position);
+        index = _mm_sub_epi32(index, _mm_and_si128(_mm_cmpgt_epi32(index, v_last_index), _mm_sub_epi32(index, v_last_index)));
+        const auto fraction = _mm_sub_ps(position, _mm_cvtepi32_ps(index));
+        alignas(16) std::array<int32_t, lanes> indices;
+        _mm_store_si128(reinterpret_cast<__m128i *>(indices.data()), index);
+        const auto low = _mm_setr_ps(curves[0].table[indices[0]], curves[1].table[indices[1]], curves[2].table[indices[2]], curves[3].table[indices[3]]);
+        const auto high = _mm_setr_ps(curves[0].table[indices[0] + 1], curves[1].table[indices[1] + 1], curves[2].table[indices[2] + 1], curves[3].table[indices[3] + 1]);
+        value = _mm_add_ps(low, _mm_mul_ps(_mm_sub_ps(high, low), fraction));
+        value = _mm_min_ps(value, v_limit);
+        _mm_storeu_ps(outputs + frame_i * lanes, value);
+        const auto quantized = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value, v_report_scale), v_report_bias));
+        const auto bytes = _mm_packus_epi16(_mm_packs_epi32(quantized, quantized), _mm_setzero_si128());
+        const auto packed = static_cast<uint32_t>(_mm_cvtsi128_si32(bytes));
+        for (size_t lane = 0; lane < lanes; lane++) reports[frame_i * lanes + lane] = static_cast<uint8_t>(packed >> (lane * 8));
+    }
+#else
+    for (size_t frame_i = 0; frame_i < num_frames; frame_i++) {
+        for (size_t lane = 0; lane < lanes; lane++) {
+            auto value = glm::clamp((inputs[frame_i * lanes + lane] - input_min[lane]) * input_scale[lane], 0.f, 1.f);
+            value = glm::min(lookup(curves[lane], value * static_cast<float>(transfer_lut::resolution)), limit[lane]);
+            outputs[frame_i * lanes + lane] = value;
+            reports[frame_i * lanes + lane] = static_cast<uint8_t>(value * 128.f + 127.5f);
+        }
+    }
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "transfer.h"
+
+#include <array>
+#include <cstdint>
+
+namespace sc::pedals {
+
+    struct axis_batch {
+
+        static constexpr size_t lanes = 4;
+
+        alignas(16) std::array<float, lanes> input_min = { 0 };
+        alignas(16) std::array<float, lanes> input_scale = { 1, 1, 1, 1 };
+        alignas(16) std::array<float, lanes> limit = { 1, 1, 1, 1 };
+        std::array<transfer_lut, lanes> curves;
+
+        axis_batch();
+
+        void configure(const size_t &lane, const transfer_settings &settings);
+        void process(const float *inputs, float *outputs, uint8_t *reports, const size_t &num_frames = 1) const;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <spdlog/spdlog.h>
+
+#include "filter.h"
+#include "pipeline.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace sl = spdlog;
+
+static std::atomic<uint64_t> num_allocations = 0;
+
+static void *allocate(const std::size_t &size) {
+    num_allocations++;
+    if (auto memory = std::malloc(size > 0 ? size : 1); memory) return memory;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size) {
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size) {
+    return allocate(size);
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+int main() {
+    constexpr size_t num_samples = 1 << 22;
+    constexpr auto lanes = sc::pedals::axis_batch::lanes;
+    constexpr float interval = 1.f / 8000.f;
+    std::vector<float> inputs(num_samples * lanes);
+    std::mt19937 generator(1234);
+    std::normal_distribution<float> noise(0.f, .01f);
+    for (size_t i = 0; i < inputs.size(); i++) inputs[i] = .5f + .4f * std::sin(i / lanes * interval * 6.28318f) + noise(generator);
+    sc::pedals::filter_chain::settings stages;
+    stages[0].type = sc::pedals::filter_stage::kind::median;
+    stages[0].window = sc::pedals::filter_chain::max_window;
+    stages[1].type = sc::pedals::filter_stage::kind::one_euro;
+    stages[1].min_cutoff = 5;
+    stages[1].beta = .05f;
+    stages[2].type = sc::pedals::filter_stage::kind::ema;
+    stages[2].alpha = .5f;
+    stages[3].type = sc::pedals::filter_stage::kind::slew;
+    stages[3].max_rate = 20;
+    std::array<sc::pedals::filter_chain, lanes> chains;
+    for (auto &chain : chains) chain.configure(stages);
+    sc::pedals::axis_batch batch;
+    std::array<float, lanes> filtered, outputs;
+    std::array<uint8_t, lanes> reports;
+    uint64_t checksum = 0;
+    const auto allocations_before = num_allocations.load();
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < num_samples; i++) {
+        for (size_t lane = 0; lane < lanes; lane++) filtered[lane] = chains[lane].process(inputs[i * lanes + lane], interval);
+        batch.process(filtered.data(), outputs.data(), reports.data());
+        for (const auto &report : reports) checksum += report;
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    const auto allocations = num_allocations.load() - allocations_before;
+    float delay = 0;
+    for (const auto &stage : stages) delay += sc::pedals::filter_chain::group_delay(stage, interval);
+    sl::info("Four stage chain on {} axes: {:.2f}M frames/sec, {:.1f} ns per frame", lanes, num_samples / elapsed / 1e6, elapsed / num_samples * 1e9);
+    sl::info("Headroom at 8 kHz: {:.0f}x", num_samples / elapsed / 8000.0);
+    sl::info("Estimated group delay at 8 kHz: {:.2f} ms", delay * 1000.f);
+    sl::info("Allocations during run: {}", allocations);
+    sl::info("Checksum: {}", checksum);
+    return allocations == 0 ? 0 : 1;
+}
\ No newline at end of file
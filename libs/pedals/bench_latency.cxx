@@ -0,0 +1,59 @@
+#include <spdlog/spdlog.h>
+
+#include "pipeline.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "../sink/recorder.h"
+
+namespace sl = spdlog;
+
+static void report_stage(const std::string_view &stage, const sc::diagnostics::histogram &histogram) {
+    const auto to_us = [](const std::chrono::nanoseconds &ns) {
+        return std::chrono::duration<double, std::micro>(ns).count();
+    };
+    sl::info("{}: {} samples, mean {:.1f} us, p50 {:.1f} us, p99 {:.1f} us, max {:.1f} us", stage, histogram.count.load(), to_us(histogram.mean()), to_us(histogram.percentile(.5)), to_us(histogram.percentile(.99)), to_us(std::chrono::nanoseconds(histogram.max_ns.load())));
+}
+
+int main(int argc, char **argv) {
+    const auto seconds = argc > 1 ? std::atoi(argv[1]) : 5;
+    const auto pipeline_hz = argc > 2 ? std::atoi(argv[2]) : 1000;
+    const auto input_hz = argc > 3 ? std::atoi(argv[3]) : 1000;
+    if (seconds <= 0 || pipeline_hz <= 0 || input_hz <= 0) {
+        sl::error("Usage: bench_latency [seconds] [pipeline_hz] [input_hz]");
+        return 1;
+    }
+    sc::pedals::transfer_settings settings;
+    settings.curve = { { 0, 0 }, { .2, .1 }, { .4, .3 }, { .6, .55 }, { .8, .8 }, { 1, 1 } };
+    sc::pedals::pipeline pipeline;
+    for (size_t lane = 0; lane < sc::pedals::axis_batch::lanes; lane++) pipeline.batch.configure(lane, settings);
+    auto source = sc::input::create_synthetic(sc::pedals::axis_batch::lanes, std::chrono::nanoseconds(1000000000 / input_hz));
+    auto recorder = std::make_unique<sc::sink::recorder>();
+    const auto &history = *recorder;
+    sc::sink::change_gate output(std::move(recorder));
+    sc::pedals::latency_stats latency;
+    sc::pedals::frame frame;
+    sl::info("Driving {} axis pipeline at {} Hz from a {} Hz synthetic source for {} s.", sc::pedals::axis_batch::lanes, pipeline_hz, input_hz, seconds);
+    const auto period = std::chrono::nanoseconds(1000000000 / pipeline_hz);
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    auto next_tick = std::chrono::steady_clock::now();
+    uint64_t num_ticks = 0;
+    while (std::chrono::steady_clock::now() < end) {
+        if (const auto err = pipeline.tick(*source, output, frame, &latency); err) {
+            sl::error(*err);
+            return 1;
+        }
+        num_ticks++;
+        next_tick += period;
+        if (const auto now = std::chrono::steady_clock::now(); next_tick < now) next_tick = now;
+        else std::this_thread::sleep_until(next_tick);
+    }
+    sl::info("Ticks: {}, submitted: {}, suppressed: {}, recorded: {}", num_ticks, output.num_submitted(), output.num_suppressed(), history.num_submitted());
+    report_stage("acquire -> process", latency.acquire_to_process);
+    report_stage("process -> submit", latency.process_to_submit);
+    report_stage("acquire -> submit", latency.end_to_end);
+    return 0;
+}
\ No newline at end of file
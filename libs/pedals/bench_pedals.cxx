@@ -0,0 +1,60 @@
+#include <spdlog/spdlog.h>
+
+#include "transfer.h"
+#include "batch.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace sl = spdlog;
+
+template<typename F>
+static double measure(const size_t &num_samples, F &&callback) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    callback();
+    const auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    return static_cast<double>(num_samples) / elapsed;
+}
+
+int main() {
+    constexpr size_t num_frames = 1 << 20;
+    constexpr size_t num_passes = 16;
+    constexpr auto lanes = sc::pedals::axis_batch::lanes;
+    sc::pedals::transfer_settings settings;
+    settings.range_min = .05f;
+    settings.range_max = .95f;
+    settings.deadzone = .02f;
+    settings.limit = .9f;
+    settings.curve = { { 0, 0 }, { .2, .1 }, { .4, .3 }, { .6, .55 }, { .8, .8 }, { 1, 1 } };
+    std::vector<float> inputs(num_frames * lanes), outputs(num_frames * lanes);
+    std::vector<uint8_t> reports(num_frames * lanes);
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> distribution(0.f, 1.f);
+    for (auto &input : inputs) input = distribution(generator);
+    const auto samples = num_frames * lanes * num_passes;
+    const auto reference_rate = measure(num_frames * lanes, [&]() {
+        for (size_t i = 0; i < num_frames * lanes; i++) outputs[i] = sc::pedals::transfer_lut::reference(settings, inputs[i]);
+    });
+    const auto lut = sc::pedals::transfer_lut::compile(settings);
+    const auto scalar_rate = measure(samples, [&]() {
+        for (size_t pass = 0; pass < num_passes; pass++) {
+            for (size_t i = 0; i < num_frames * lanes; i++) {
+                outputs[i] = lut.evaluate(inputs[i]);
+                reports[i] = static_cast<uint8_t>(outputs[i] * 128.f + 127.5f);
+            }
+        }
+    });
+    sc::pedals::axis_batch batch;
+    for (size_t lane = 0; lane < lanes; lane++) batch.configure(lane, settings);
+    const auto batch_rate = measure(samples, [&]() {
+        for (size_t pass = 0; pass < num_passes; pass++) batch.process(inputs.data(), outputs.data(), reports.data(), num_frames);
+    });
+    uint64_t checksum = 0;
+    for (const auto &report : reports) checksum += report;
+    sl::info("bezier::calculate: {:.2f}M samples/sec", reference_rate / 1e6);
+    sl::info("transfer_lut: {:.2f}M samples/sec", scalar_rate / 1e6);
+    sl::info("axis_batch: {:.2f}M samples/sec ({:.2f}M frames/sec of {} axes)", batch_rate / 1e6, batch_rate / lanes / 1e6, lanes);
+    sl::info("Checksum: {}", checksum);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,277 @@
+#include <spdlog/spdlog.h>
+
+#include "pipeline.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../file/file.h"
+#include "../input/replay.h"
+
+namespace sl = spdlog;
+
+static constexpr auto lanes = sc::pedals::axis_batch::lanes;
+static constexpr std::array<char, 4> golden_magic = { 'S', 'C', 'R', 'G' };
+static constexpr uint32_t golden_version = 1;
+
+struct golden_header {
+
+    std::array<char, 4> magic;
+    uint32_t version;
+    uint32_t num_lanes;
+    uint32_t reserved;
+    uint64_t num_samples;
+};
+
+struct golden_entry {
+
+    std::array<float, lanes> legacy;
+    std::array<uint8_t, lanes> report;
+    std::array<float, lanes> mk4;
+};
+
+static_assert(sizeof(golden_header) == 24 && sizeof(golden_entry) == lanes * 9, "golden files are written straight to disk");
+
+struct replay_result {
+
+    std::vector<golden_entry> entries;
+    double legacy_seconds = 0, mk4_seconds = 0;
+    std::chrono::nanoseconds max_lateness { 0 };
+    size_t num_late = 0;
+};
+
+struct discard_sink : sc::sink::output_sink {
+
+    std::string_view name() const override {
+        return "discard";
+    }
+
+    std::optional<std::string> submit(const sc::sink::gamepad_report &) override {
+        return std::nullopt;
+    }
+};
+
+static std::array<sc::pedals::transfer_settings, lanes> replay_transfers() {
+    std::array<sc::pedals::transfer_settings, lanes> result;
+    result[0].curve = { { 0, 0 }, { .2, .1 }, { .4, .3 }, { .6, .55 }, { .8, .8 }, { 1, 1 } };
+    result[1].range_min = .05f;
+    result[1].range_max = .95f;
+    result[1].deadzone = .02f;
+    result[1].curve = { { 0, 0 }, { .2, .35 }, { .4, .6 }, { .6, .75 }, { .8, .9 }, { 1, 1 } };
+    result[2].limit = .8f;
+    result[3].range_min = .1f;
+    result[3].curve = { { 0, 0 }, { 1, 1 } };
+    return result;
+}
+
+static std::array<sc::pedals::filter_chain::settings, lanes> replay_filters() {
+    std::array<sc::pedals::filter_chain::settings, lanes> result;
+    result[1][0].type = sc::pedals::filter_stage::kind::ema;
+    result[1][0].alpha = .3f;
+    result[2][0].type = sc::pedals::filter_stage::kind::median;
+    result[2][0].window = 5;
+    result[3][0].type = sc::pedals::filter_stage::kind::one_euro;
+    result[3][1].type = sc::pedals::filter_stage::kind::slew;
+    result[3][1].max_rate = 20;
+    return result;
+}
+
+static sc::input::recording generate(const size_t &num_samples) {
+    sc::input::recording result;
+    std::mt19937 generator(1234);
+    std::normal_distribution<float> noise(0.f, .002f);
+    sc::input::sample sample;
+    sample.num_axes = lanes;
+    for (size_t i = 0; i < num_samples; i++) {
+        sample.time = std::chrono::steady_clock::time_point(std::chrono::microseconds(i * 1000 + (i % 7) * 20));
+        const auto phase = static_cast<double>(i) / 1000.0;
+        for (size_t lane = 0; lane < lanes; lane++) sample.axes[lane] = std::clamp(static_cast<float>(.5 + .5 * std::sin(phase * (lane + 1) * 1.7)) + noise(generator), 0.f, 1.f);
+        result.append(sample, std::chrono::steady_clock::time_point());
+    }
+    return result;
+}
+
+static tl::expected<replay_result, std::string> replay(const std::shared_ptr<const sc::input::recording> &samples, const bool &realtime) {
+    const auto transfers = replay_transfers();
+    const auto filters = replay_filters();
+    sc::pedals::pipeline pipeline;
+    for (size_t lane = 0; lane < lanes; lane++) {
+        pipeline.batch.configure(lane, transfers[lane]);
+        pipeline.filters[lane].configure(filters[lane]);
+    }
+    sc::input::replay_source source(samples);
+    sc::sink::change_gate output(std::make_unique<discard_sink>());
+    sc::pedals::frame frame;
+    replay_result result;
+    result.entries.resize(samples->size());
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < samples->size(); i++) {
+        if (realtime) {
+            const auto due = start + (samples->times[i] - samples->times.front());
+            std::this_thread::sleep_until(due);
+            const auto lateness = std::chrono::steady_clock::now() - due;
+            if (lateness > result.max_lateness) result.max_lateness = lateness;
+            if (lateness > std::chrono::milliseconds(1)) result.num_late++;
+        }
+        if (const auto err = pipeline.tick(source, output, frame); err) return tl::make_unexpected(*err);
+        result.entries[i].legacy = frame.outputs;
+        std::copy_n(pipeline.report.axes.begin(), lanes, result.entries[i].report.begin());
+    }
+    result.legacy_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto mk4_start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < samples->size(); i++) {
+        const auto sample = samples->at(i);
+        for (size_t lane = 0; lane < lanes; lane++) result.entries[i].mk4[lane] = sc::pedals::transfer_lut::reference(transfers[lane], lane < sample.num_axes ? sample.axes[lane] : 0.f);
+    }
+    result.mk4_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - mk4_start).count();
+    return result;
+}
+
+static std::optional<std::string> save_golden(const std::filesystem::path &path, const std::vector<golden_entry> &entries) {
+    const golden_header header = { golden_magic, golden_version, lanes, 0, entries.size() };
+    std::vector<std::byte> data(sizeof(header) + entries.size() * sizeof(golden_entry));
+    memcpy(data.data(), &header, sizeof(header));
+    memcpy(data.data() + sizeof(header), entries.data(), entries.size() * sizeof(golden_entry));
+    return sc::file::save(path, data);
+}
+
+static tl::expected<std::vector<golden_entry>, std::string> load_golden(const std::filesystem::path &path) {
+    const auto load_res = sc::file::load(path);
+    if (!load_res.has_value()) return tl::make_unexpected(load_res.error());
+    golden_header header;
+    if (load_res->size() < sizeof(header)) return tl::make_unexpected("Golden file is too short.");
+    memcpy(&header, load_res->data(), sizeof(header));
+    if (header.magic != golden_magic || header.version != golden_version || header.num_lanes != lanes) return tl::make_unexpected("Golden file has an unsupported format.");
+    if (load_res->size() != sizeof(header) + header.num_samples * sizeof(golden_entry)) return tl::make_unexpected("Golden file has an unexpected size.");
+    std::vector<golden_entry> entries(header.num_samples);
+    memcpy(entries.data(), load_res->data() + sizeof(header), entries.size() * sizeof(golden_entry));
+    return entries;
+}
+
+static size_t compare(const std::vector<golden_entry> &expected, const std::vector<golden_entry> &actual) {
+    size_t num_mismatched = 0;
+    for (size_t i = 0; i < std::min(expected.size(), actual.size()); i++) {
+        if (memcmp(&expected[i], &actual[i], sizeof(golden_entry)) == 0) continue;
+        if (num_mismatched++ > 0) continue;
+        for (size_t lane = 0; lane < lanes; lane++) {
+            if (memcmp(&expected[i].legacy[lane], &actual[i].legacy[lane], sizeof(float)) != 0 || expected[i].report[lane] != actual[i].report[lane]) sl::error("First legacy mismatch at sample #{}, lane {}: expected {} ({}), got {} ({}).", i, lane, expected[i].legacy[lane], expected[i].report[lane], actual[i].legacy[lane], actual[i].report[lane]);
+            if (memcmp(&expected[i].mk4[lane], &actual[i].mk4[lane], sizeof(float)) != 0) sl::error("First MK4 mismatch at sample #{}, lane {}: expected {}, got {}.", i, lane, expected[i].mk4[lane], actual[i].mk4[lane]);
+        }
+    }
+    return num_mismatched + std::max(expected.size(), actual.size()) - std::min(expected.size(), actual.size());
+}
+
+static void report(const replay_result &result, const bool &realtime) {
+    const auto num_samples = static_cast<double>(result.entries.size());
+    if (realtime) sl::info("Real time: {} samples in {:.2f} s, max lateness {:.3f} ms, {} samples more than 1 ms late.", result.entries.size(), result.legacy_seconds, std::chrono::duration<double, std::milli>(result.max_lateness).count(), result.num_late);
+    else sl::info("Legacy pipeline: {:.2f}M samples/sec", num_samples / result.legacy_seconds / 1e6);
+    sl::info("MK4 reference: {:.2f}M samples/sec", num_samples / result.mk4_seconds / 1e6);
+}
+
+static int record(const std::filesystem::path &path, const int &seconds, const std::optional<std::string> &device_name) {
+    std::unique_ptr<sc::input::source> source;
+    if (!device_name) source = sc::input::create_synthetic(lanes, std::chrono::milliseconds(1));
+    else {
+#if defined(_WIN32)
+        auto source_res = sc::input::create_winmm(*device_name);
+#elif defined(__linux__)
+        auto source_res = sc::input::create_evdev(*device_name);
+#else
+        tl::expected<std::unique_ptr<sc::input::source>, std::string> source_res = tl::make_unexpected("No input backend on this platform.");
+#endif
+        if (!source_res.has_value()) {
+            sl::error(source_res.error());
+            return 1;
+        }
+        source = std::move(*source_res);
+    }
+    sl::info("Recording {} for {} s.", source->name(), seconds);
+    sc::input::recording samples;
+    std::optional<uint64_t> last_sequence;
+    std::optional<std::chrono::steady_clock::time_point> first_time;
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    while (std::chrono::steady_clock::now() < end) {
+        if (const auto sample = source->latest(); sample && sample->sequence != last_sequence) {
+            if (!first_time) first_time = sample->time;
+            samples.append(*sample, *first_time);
+            last_sequence = sample->sequence;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(250));
+    }
+    if (const auto err = samples.save(path); err) {
+        sl::error(*err);
+        return 1;
+    }
+    sl::info("Recorded {} samples of {} axes to {}.", samples.size(), samples.num_axes, path.string());
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "record" && argc > 2) return record(argv[2], argc > 3 ? std::atoi(argv[3]) : 10, argc > 4 ? std::optional<std::string>(argv[4]) : std::nullopt);
+    if (mode == "generate" && argc > 2) {
+        const auto samples = generate(argc > 3 ? static_cast<size_t>(std::atoi(argv[3])) : 2000);
+        if (const auto err = samples.save(argv[2]); err) {
+            sl::error(*err);
+            return 1;
+        }
+        sl::info("Generated {} samples of {} axes to {}.", samples.size(), samples.num_axes, argv[2]);
+        return 0;
+    }
+    std::shared_ptr<const sc::input::recording> samples;
+    if (mode.empty()) samples = std::make_shared<sc::input::recording>(generate(1 << 18));
+    else if ((mode == "bless" || mode == "check") && argc > 3) {
+        auto recording_res = sc::input::recording::load(argv[2]);
+        if (!recording_res.has_value()) {
+            sl::error("Unable to load recording: {}", recording_res.error());
+            return 1;
+        }
+        samples = std::make_shared<sc::input::recording>(std::move(*recording_res));
+    } else {
+        sl::error("Usage: bench_replay [record <recording> [seconds] [device] | generate <recording> [samples] | bless <recording> <golden> | check <recording> <golden> [realtime]]");
+        return 1;
+    }
+    const auto realtime = mode == "check" && argc > 4 && std::string(argv[4]) == "realtime";
+    sl::info("Replaying {} samples of {} axes{}.", samples->size(), samples->num_axes, realtime ? " in real time" : "");
+    const auto result_res = replay(samples, realtime);
+    if (!result_res.has_value()) {
+        sl::error(result_res.error());
+        return 1;
+    }
+    report(*result_res, realtime);
+    if (mode == "bless") {
+        if (const auto err = save_golden(argv[3], result_res->entries); err) {
+            sl::error(*err);
+            return 1;
+        }
+        sl::info("Wrote golden outputs to {}.", argv[3]);
+        return 0;
+    }
+    std::vector<golden_entry> expected;
+    if (mode.empty()) {
+        const auto again_res = replay(samples, false);
+        if (!again_res.has_value()) {
+            sl::error(again_res.error());
+            return 1;
+        }
+        expected = again_res->entries;
+    } else {
+        auto golden_res = load_golden(argv[3]);
+        if (!golden_res.has_value()) {
+            sl::error("Unable to load golden outputs: {}", golden_res.error());
+            return 1;
+        }
+        expected = std::move(*golden_res);
+    }
+    if (const auto num_mismatched = compare(expected, result_res->entries); num_mismatched > 0) {
+        sl::error("{} of {} samples differ from the golden outputs.", num_mismatched, expected.size());
+        return 1;
+    }
+    sl::info("All {} samples match bit for bit.", expected.size());
+    return 0;
+}
\ No newline at end of file
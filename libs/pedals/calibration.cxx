@@ -0,0 +1,123 @@
+#include "calibration.h"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <glm/common.hpp>
+
+#include "../defer.hpp"
+#include "../file/file.h"
+
+static_assert(std::is_trivially_copyable_v<sc::pedals::calibration_set>, "calibration sets are mapped straight from disk");
+
+sc::pedals::calibration_table sc::pedals::calibration_table::identity() {
+    calibration_table result;
+    for (size_t i = 0; i <= resolution; i++) result.table[i] = static_cast<float>(i) / static_cast<float>(resolution);
+    return result;
+}
+
+float sc::pedals::calibration_table::evaluate(const float &input) const {
+    const auto position = glm::clamp(input, 0.f, 1.f) * static_cast<float>(resolution);
+    const auto index = glm::min(static_cast<size_t>(position), resolution - 1);
+    const auto fraction = position - static_cast<float>(index);
+    return table[index] + (table[index + 1] - table[index]) * fraction;
+}
+
+void sc::pedals::calibration_recorder::stop() {
+    recording = false;
+    while (writers.load() > 0) std::this_thread::yield();
+}
+
+void sc::pedals::calibration_recorder::reset() {
+    stop();
+    for (auto &bin : bins) bin.store(0, std::memory_order_relaxed);
+    peak = -1;
+    count.store(0, std::memory_order_release);
+    recording = true;
+}
+
+void sc::pedals::calibration_recorder::record(const float &input) {
+    writers++;
+    DEFER(
+        writers--;
+    );
+    if (!recording) return;
+    if (input < peak - stroke_tolerance) return;
+    peak = glm::max(peak, input);
+    const auto bin = glm::min(static_cast<size_t>(glm::clamp(input, 0.f, 1.f) * static_cast<float>(num_bins)), num_bins - 1);
+    bins[bin].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t sc::pedals::calibration_recorder::num_samples() const {
+    return count.load(std::memory_order_acquire);
+}
+
+tl::expected<sc::pedals::calibration_table, std::string> sc::pedals::calibration_recorder::build() {
+    stop();
+    std::vector<size_t> occupied;
+    for (size_t i = 0; i < num_bins; i++) {
+        if (bins[i].load(std::memory_order_relaxed)) occupied.push_back(i);
+    }
+    // A bin stands for the travel up to the next recorded bin, so sparse strokes and quantized inputs compare as densities.
+    std::vector<double> widths(occupied.size()), densities(occupied.size()), weights(num_bins, 0), neighbours;
+    for (size_t k = 0; k < occupied.size(); k++) {
+        widths[k] = k + 1 < occupied.size() ? static_cast<double>(occupied[k + 1] - occupied[k]) : 1;
+        densities[k] = static_cast<double>(bins[occupied[k]].load(std::memory_order_relaxed)) / widths[k];
+    }
+    // Dwelling in place piles samples into a few bins; cap those at a multiple of the local stroke density.
+    for (size_t k = 0, first = 0, last = 0; k < occupied.size(); k++) {
+        while (occupied[first] + dwell_window < occupied[k]) first++;
+        while (last < occupied.size() && occupied[last] <= occupied[k] + dwell_window) last++;
+        neighbours.assign(densities.begin() + first, densities.begin() + last);
+        std::nth_element(neighbours.begin(), neighbours.begin() + neighbours.size() / 2, neighbours.end());
+        weights[occupied[k]] = std::min(densities[k], neighbours[neighbours.size() / 2] * dwell_limit) * widths[k];
+    }
+    std::vector<double> cumulative(num_bins + 1, 0);
+    for (size_t i = 0; i < num_bins; i++) cumulative[i + 1] = cumulative[i] + weights[i];
+    const auto total = cumulative.back();
+    const auto recorded = count.load(std::memory_order_acquire);
+    const auto required = std::max(std::min<uint64_t>(min_samples, occupied.size() * min_samples_per_bin), min_samples_per_bin);
+    if (recorded < required) return tl::make_unexpected(fmt::format("The sweep recorded {} samples, at least {} are needed.", recorded, required));
+    const auto first_bin = occupied.front(), last_bin = occupied.back();
+    const auto sweep_min = static_cast<float>(first_bin) / static_cast<float>(num_bins);
+    const auto sweep_max = static_cast<float>(last_bin + 1) / static_cast<float>(num_bins);
+    if (last_bin - first_bin < num_bins / 10) return tl::make_unexpected("The sweep did not cover enough of the pedal travel.");
+    calibration_table result;
+    for (size_t i = 0; i <= calibration_table::resolution; i++) {
+        const auto input = static_cast<float>(i) / static_cast<float>(calibration_table::resolution);
+        if (input <= sweep_min || input >= sweep_max) {
+            result.table[i] = input;
+            continue;
+        }
+        const auto position = input * static_cast<float>(num_bins);
+        const auto bin = glm::min(static_cast<size_t>(position), num_bins - 1);
+        const auto fraction = position - static_cast<float>(bin);
+        const auto rank = cumulative[bin] + (cumulative[bin + 1] - cumulative[bin]) * fraction;
+        result.table[i] = sweep_min + (sweep_max - sweep_min) * static_cast<float>(rank / total);
+    }
+    for (size_t i = 1; i <= calibration_table::resolution; i++) result.table[i] = glm::max(result.table[i], result.table[i - 1]);
+    return result;
+}
+
+tl::expected<std::shared_ptr<const sc::pedals::calibration_set>, std::string> sc::pedals::calibration_set::load(const std::filesystem::path &path) {
+    const auto mapping_res = file::mapping::open(path);
+    if (!mapping_res.has_value()) return tl::make_unexpected(mapping_res.error());
+    const auto &mapping = *mapping_res;
+    if (mapping->size() != sizeof(calibration_set)) return tl::make_unexpected("Calibration file has an unexpected size.");
+    const auto set = reinterpret_cast<const calibration_set *>(mapping->data());
+    if (set->magic != expected_magic || set->version != expected_version) return tl::make_unexpected("Calibration file has an unsupported format.");
+    if (set->num_axes != axis_batch::lanes || set->resolution != calibration_table::resolution) return tl::make_unexpected("Calibration file was recorded with a different layout.");
+    return std::shared_ptr<const calibration_set>(mapping, set);
+}
+
+std::optional<std::string> sc::pedals::calibration_set::save(const std::filesystem::path &path, const calibration_set &set) {
+    std::vector<std::byte> data(sizeof(calibration_set));
+    memcpy(data.data(), &set, sizeof(calibration_set));
+    return file::save(path, data);
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "batch.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <tl/expected.hpp>
+
+namespace sc::pedals {
+
+    struct calibration_table {
+
+        static constexpr size_t resolution = 256;
+
+        std::array<float, resolution + 1> table = { 0 };
+
+        static calibration_table identity();
+
+        float evaluate(const float &input) const;
+    };
+
+    struct calibration_recorder {
+
+        static constexpr size_t num_bins = 4096;
+        static constexpr uint64_t min_samples = 1000;
+        static constexpr uint64_t min_samples_per_bin = 4;
+        static constexpr float stroke_tolerance = 1.f / 256.f;
+        static constexpr size_t dwell_window = 64;
+        static constexpr double dwell_limit = 2;
+
+        // Stops recording, waits for a running record call and clears the sweep.
+        void reset();
+        void record(const float &input);
+        uint64_t num_samples() const;
+
+        // Stops recording and waits for a running record call before reading the sweep.
+        tl::expected<calibration_table, std::string> build();
+
+    private:
+
+        std::array<std::atomic<uint32_t>, num_bins> bins = { };
+        std::atomic<uint64_t> count = 0;
+        std::atomic_bool recording = true;
+        std::atomic_int writers = 0;
+        float peak = -1;
+
+        void stop();
+    };
+
+    struct calibration_set {
+
+        static constexpr std::array<char, 4> expected_magic = { 'S', 'C', 'C', 'L' };
+        static constexpr uint32_t expected_version = 1;
+
+        std::array<char, 4> magic = expected_magic;
+        uint32_t version = expected_version;
+        uint32_t num_axes = axis_batch::lanes;
+        uint32_t resolution = calibration_table::resolution;
+        std::array<uint32_t, axis_batch::lanes> present = { 0 };
+        std::array<calibration_table, axis_batch::lanes> tables;
+
+        static tl::expected<std::shared_ptr<const calibration_set>, std::string> load(const std::filesystem::path &path);
+        static std::optional<std::string> save(const std::filesystem::path &path, const calibration_set &set);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "filter.h"
+
+#include <glm/common.hpp>
+#include <glm/gtc/constants.hpp>
+
+namespace sc::pedals {
+
+    static float smoothing_factor(const float &cutoff, const float &interval) {
+        const auto tau = 1.f / (2.f * glm::pi<float>() * glm::max(cutoff, 1e-3f));
+        return 1.f / (1.f + tau / interval);
+    }
+
+    static float median(const std::array<float, filter_chain::max_window> &history, const int &size) {
+        std::array<float, filter_chain::max_window> sorted = history;
+        for (int i = 1; i < size; i++) {
+            const auto value = sorted[i];
+            auto j = i;
+            for (; j > 0 && sorted[j - 1] > value; j--) sorted[j] = sorted[j - 1];
+            sorted[j] = value;
+        }
+        return sorted[size / 2];
+    }
+}
+
+bool sc::pedals::filter_stage::operator==(const filter_stage &other) const {
+    return type == other.type && alpha == other.alpha && window == other.window && min_cutoff == other.min_cutoff && beta == other.beta && derivative_cutoff == other.derivative_cutoff && max_rate == other.max_rate;
+}
+
+bool sc::pedals::filter_stage::operator!=(const filter_stage &other) const {
+    return !(*this == other);
+}
+
+void sc::pedals::filter_chain::configure(const settings &stages) {
+    requested = stages;
+    this->stages = stages;
+    for (auto &stage : this->stages) {
+        stage.alpha = glm::clamp(stage.alpha, 1e-3f, 1.f);
+        stage.window = glm::clamp(stage.window, 1, static_cast<int>(max_window));
+        stage.min_cutoff = glm::max(stage.min_cutoff, 1e-3f);
+        stage.beta = glm::max(stage.beta, 0.f);
+        stage.derivative_cutoff = glm::max(stage.derivative_cutoff, 1e-3f);
+        stage.max_rate = glm::max(stage.max_rate, 0.f);
+    }
+    reset();
+}
+
+const sc::pedals::filter_chain::settings &sc::pedals::filter_chain::configuration() const {
+    return requested;
+}
+
+void sc::pedals::filter_chain::reset() {
+    states.fill({ });
+}
+
+float sc::pedals::filter_chain::process(const float &input, const float &interval) {
+    auto value = input;
+    const auto dt = glm::max(interval, 1e-6f);
+    for (size_t i = 0; i < max_stages; i++) {
+        const auto &stage = stages[i];
+        auto &state = states[i];
+        if (stage.type == filter_stage::kind::none) continue;
+        if (stage.type == filter_stage::kind::median) {
+            state.history[state.history_i] = value;
+            state.history_i = (state.history_i + 1) % stage.window;
+            if (state.history_size < stage.window) state.history_size++;
+            value = median(state.history, state.history_size);
+            continue;
+        }
+        if (!state.primed) {
+            state.primed = true;
+            state.value = value;
+            state.derivative = 0;
+            continue;
+        }
+        switch (stage.type) {
+            case filter_stage::kind::ema:
+                state.value += stage.alpha * (value - state.value);
+                break;
+            case filter_stage::kind::one_euro: {
+                const auto derivative = (value - state.value) / dt;
+                state.derivative += smoothing_factor(stage.derivative_cutoff, dt) * (derivative - state.derivative);
+                const auto cutoff = stage.min_cutoff + stage.beta * glm::abs(state.derivative);
+                state.value += smoothing_factor(cutoff, dt) * (value - state.value);
+                break;
+            }
+            case filter_stage::kind::slew: {
+                const auto max_step = stage.max_rate * dt;
+                state.value += glm::clamp(value - state.value, -max_step, max_step);
+                break;
+            }
+            default:
+                break;
+        }
+        value = state.value;
+    }
+    return value;
+}
+
+float sc::pedals::filter_chain::group_delay(const filter_stage &stage, const float &interval) {
+    switch (stage.type) {
+        case filter_stage::kind::ema: {
+            const auto alpha = glm::clamp(stage.alpha, 1e-3f, 1.f);
+            return (1.f - alpha) / alpha * interval;
+        }
+        case filter_stage::kind::median:
+            return (glm::clamp(static_cast<int>(stage.window), 1, static_cast<int>(max_window)) - 1) / 2.f * interval;
+        case filter_stage::kind::one_euro: {
+            const auto alpha = smoothing_factor(stage.min_cutoff, interval);
+            return (1.f - alpha) / alpha * interval;
+        }
+        default:
+            return 0;
+    }
+}
\ No newline at end of file
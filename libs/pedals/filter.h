@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/*
+
+Per-axis input filters, applied to the normalized hardware reading before the
+range and curve mapping. Every stage keeps its state in fixed-size members, so
+a chain never allocates and costs the same on every sample.
+
+Group delay, for a chain running at a sample interval of T seconds:
+
+    ema         y += alpha * (x - y)
+                (1 - alpha) / alpha samples at low frequencies.
+
+    median      Median of the last `window` samples.
+                (window - 1) / 2 samples for any slow-moving signal; a spike
+                shorter than half the window never reaches the output.
+
+    one_euro    EMA whose cutoff rises with speed: fc = min_cutoff + beta * |dx/dt|.
+                About 1 / (2 * pi * fc) seconds, so the full min_cutoff delay
+                while the pedal is held and much less while it is moving.
+
+    slew        Limits |dy/dt| to max_rate full-scale units per second.
+                No delay while the input moves slower than max_rate; a faster
+                step lags by (step - max_rate * T) / max_rate seconds.
+
+The delay of a chain is the sum of its stages.
+
+*/
+
+namespace sc::pedals {
+
+    struct filter_stage {
+
+        enum class kind {
+
+            none,
+            ema,
+            median,
+            one_euro,
+            slew
+        };
+
+        kind type = kind::none;
+        float alpha = 1;
+        int window = 3;
+        float min_cutoff = 1, beta = 0, derivative_cutoff = 1;
+        float max_rate = 10;
+
+        bool operator==(const filter_stage &other) const;
+        bool operator!=(const filter_stage &other) const;
+    };
+
+    struct filter_chain {
+
+        static constexpr size_t max_stages = 4;
+        static constexpr size_t max_window = 9;
+
+        using settings = std::array<filter_stage, max_stages>;
+
+        void configure(const settings &stages);
+        const settings &configuration() const;
+        void reset();
+        float process(const float &input, const float &interval);
+
+        static float group_delay(const filter_stage &stage, const float &interval);
+
+    private:
+
+        struct stage_state {
+
+            bool primed = false;
+            float value = 0, derivative = 0;
+            std::array<float, max_window> history = { 0 };
+            int history_i = 0, history_size = 0;
+        };
+
+        settings requested, stages;
+        std::array<stage_state, max_stages> states;
+    };
+}
\ No newline at end of file
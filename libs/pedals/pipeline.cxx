@@ -0,0 +1,54 @@
+#include "pipeline.h"
+
+#include <algorithm>
+#include <chrono>
+
+void sc::pedals::latency_stats::reset() {
+    acquire_to_process.reset();
+    process_to_submit.reset();
+    end_to_end.reset();
+}
+
+sc::pedals::pipeline::pipeline() {
+    report.trigger_left = 128;
+    report.trigger_right = 128;
+}
+
+std::optional<std::string> sc::pedals::pipeline::tick(input::source &source, sink::change_gate &output, frame &result, latency_stats *latency) {
+    const auto sample = source.latest();
+    result.present = sample.has_value();
+    result.num_axes = sample ? std::min(sample->num_axes, axis_batch::lanes) : 0;
+    for (size_t i = 0; i < result.inputs.size(); i++) result.inputs[i] = i < result.num_axes ? sample->axes[i] : 0.f;
+    const auto fresh = sample && sample->sequence != last_sequence;
+    result.fresh = fresh;
+    if (fresh) {
+        const auto interval = last_sample_time ? std::chrono::duration<float>(sample->time - *last_sample_time).count() : 0.f;
+        for (size_t i = 0; i < filtered.size(); i++) {
+            const auto linear = calibration && calibration->present[i] ? calibration->tables[i].evaluate(result.inputs[i]) : result.inputs[i];
+            filtered[i] = filters[i].process(linear, interval);
+            if (ranging[i] && i < result.num_axes) ranges[i].record(filtered[i]);
+        }
+        last_sequence = sample->sequence;
+        last_sample_time = sample->time;
+    } else if (!sample && last_sample_time) {
+        for (auto &filter : filters) filter.reset();
+        filtered.fill(0);
+        last_sample_time.reset();
+    }
+    result.filtered = filtered;
+    std::array<uint8_t, axis_batch::lanes> quantized;
+    batch.process(result.filtered.data(), result.outputs.data(), quantized.data());
+    for (size_t i = 0; i < result.num_axes; i++) report.axes[i] = quantized[i];
+    const auto processed = std::chrono::steady_clock::now();
+    const auto num_submitted = output.num_submitted();
+    const auto err = output.submit(report);
+    const auto submitted = std::chrono::steady_clock::now();
+    if (latency && fresh) {
+        latency->acquire_to_process.record(processed - sample->time);
+        if (output.num_submitted() != num_submitted) {
+            latency->process_to_submit.record(submitted - processed);
+            latency->end_to_end.record(submitted - sample->time);
+        }
+    }
+    return err;
+}
\ No newline at end of file
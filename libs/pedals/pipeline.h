@@ -0,0 +1,53 @@
+#pragma once
+
+#include "autorange.h"
+#include "batch.h"
+#include "calibration.h"
+#include "filter.h"
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "../diagnostics/diagnostics.h"
+#include "../input/input.h"
+#include "../sink/gate.h"
+
+namespace sc::pedals {
+
+    struct latency_stats {
+
+        diagnostics::histogram acquire_to_process, process_to_submit, end_to_end;
+
+        void reset();
+    };
+
+    struct frame {
+
+        bool present = false, fresh = false;
+        size_t num_axes = 0;
+        std::array<float, axis_batch::lanes> inputs = { 0 }, filtered = { 0 }, outputs = { 0 };
+    };
+
+    struct pipeline {
+
+        axis_batch batch;
+        std::array<filter_chain, axis_batch::lanes> filters;
+        std::shared_ptr<const calibration_set> calibration;
+        std::array<auto_range, axis_batch::lanes> ranges;
+        std::array<bool, axis_batch::lanes> ranging = { false };
+        sink::gamepad_report report;
+
+        pipeline();
+
+        std::optional<std::string> tick(input::source &source, sink::change_gate &output, frame &result, latency_stats *latency = nullptr);
+
+    private:
+
+        std::optional<uint64_t> last_sequence;
+        std::optional<std::chrono::steady_clock::time_point> last_sample_time;
+        std::array<float, axis_batch::lanes> filtered = { 0 };
+    };
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "spline.h"
+
+#include <algorithm>
+#include <cmath>
+
+sc::pedals::monotone_spline sc::pedals::monotone_spline::fit(std::vector<glm::dvec2> points) {
+    monotone_spline result;
+    std::stable_sort(points.begin(), points.end(), [](const glm::dvec2 &a, const glm::dvec2 &b) {
+        return a.x < b.x;
+    });
+    for (const auto &point : points) {
+        if (!result.x.empty() && point.x <= result.x.back()) continue;
+        result.x.push_back(point.x);
+        result.y.push_back(point.y);
+    }
+    const auto n = result.x.size();
+    result.slopes.assign(n, 0.0);
+    if (n < 2) return result;
+    std::vector<double> secants(n - 1);
+    for (size_t k = 0; k + 1 < n; k++) secants[k] = (result.y[k + 1] - result.y[k]) / (result.x[k + 1] - result.x[k]);
+    result.slopes.front() = secants.front();
+    result.slopes.back() = secants.back();
+    for (size_t k = 1; k + 1 < n; k++) result.slopes[k] = secants[k - 1] * secants[k] > 0 ? (secants[k - 1] + secants[k]) * .5 : 0.0;
+    for (size_t k = 0; k + 1 < n; k++) {
+        if (secants[k] == 0) {
+            result.slopes[k] = 0;
+            result.slopes[k + 1] = 0;
+            continue;
+        }
+        const auto a = result.slopes[k] / secants[k];
+        const auto b = result.slopes[k + 1] / secants[k];
+        if (a < 0) result.slopes[k] = 0;
+        if (b < 0) result.slopes[k + 1] = 0;
+        if (const auto length = a * a + b * b; length > 9) {
+            const auto tau = 3 / std::sqrt(length);
+            result.slopes[k] = tau * a * secants[k];
+            result.slopes[k + 1] = tau * b * secants[k];
+        }
+    }
+    return result;
+}
+
+double sc::pedals::monotone_spline::evaluate(const double &input) const {
+    if (x.empty()) return input;
+    if (x.size() == 1 || input <= x.front()) return y.front();
+    if (input >= x.back()) return y.back();
+    const auto k = static_cast<size_t>(std::upper_bound(x.begin(), x.end(), input) - x.begin()) - 1;
+    const auto h = x[k + 1] - x[k];
+    const auto t = (input - x[k]) / h;
+    const auto t2 = t * t, t3 = t2 * t;
+    return (2 * t3 - 3 * t2 + 1) * y[k] + (t3 - 2 * t2 + t) * h * slopes[k] + (-2 * t3 + 3 * t2) * y[k + 1] + (t3 - t2) * h * slopes[k + 1];
+}
\ No newline at end of file
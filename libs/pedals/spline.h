@@ -0,0 +1,17 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+namespace sc::pedals {
+
+    struct monotone_spline {
+
+        std::vector<double> x, y, slopes;
+
+        static monotone_spline fit(std::vector<glm::dvec2> points);
+
+        double evaluate(const double &input) const;
+    };
+}
\ No newline at end of file
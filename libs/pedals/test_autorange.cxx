@@ -0,0 +1,48 @@
+#include <spdlog/spdlog.h>
+
+#include "autorange.h"
+
+#include <random>
+
+#include <glm/common.hpp>
+
+namespace sl = spdlog;
+
+int main() {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    for (const auto quantile : { .01, .5, .9, .99 }) {
+        sc::pedals::p2_quantile estimator(quantile);
+        for (int i = 0; i < 100000; i++) estimator.record(uniform(generator));
+        if (glm::abs(estimator.estimate() - quantile) > .01) {
+            sl::error("P2 estimate of quantile {} is {}.", quantile, estimator.estimate());
+            return 1;
+        }
+    }
+    sc::pedals::auto_range range;
+    std::normal_distribution<float> noise(0.f, .002f);
+    for (int i = 0; i < 100; i++) range.record(.12f + noise(generator));
+    if (range.current().ready) {
+        sl::error("Auto range reports an estimate before it has enough samples.");
+        return 1;
+    }
+    for (int lap = 0; lap < 20; lap++) {
+        for (int i = 0; i < 5000; i++) range.record(.12f + noise(generator));
+        for (int i = 0; i < 200; i++) range.record(.12f + (.86f - .12f) * i / 200.f + noise(generator));
+        for (int i = 0; i < 800; i++) range.record(.86f + noise(generator));
+        for (int i = 0; i < 200; i++) range.record(.86f - (.86f - .12f) * i / 200.f + noise(generator));
+        if (lap == 10) range.record(1.f);
+    }
+    const auto estimate = range.current();
+    sl::info("Auto range: {} .. {}", estimate.min, estimate.max);
+    if (!estimate.ready || glm::abs(estimate.min - .12f) > .01f || glm::abs(estimate.max - .86f) > .01f) {
+        sl::error("Auto range does not find the resting and fully pressed positions.");
+        return 1;
+    }
+    range.reset();
+    if (range.current().ready) {
+        sl::error("Auto range keeps its estimate after a reset.");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include <spdlog/spdlog.h>
+
+#include "calibration.h"
+
+#include <filesystem>
+#include <random>
+
+#include <glm/common.hpp>
+
+namespace sl = spdlog;
+
+int main() {
+    const auto sensor = [](const float &position) {
+        return .1f + .8f * position * (.5f + .5f * position);
+    };
+    sc::pedals::calibration_recorder recorder;
+    for (int i = 0; i < 100; i++) recorder.record(sensor(i / 100.f));
+    if (recorder.build().has_value()) {
+        sl::error("Calibration accepted a sweep with too few samples.");
+        return 1;
+    }
+    recorder.reset();
+    constexpr int num_steps = 200000;
+    for (int i = 0; i <= num_steps; i++) recorder.record(sensor(static_cast<float>(i) / num_steps));
+    const auto table_res = recorder.build();
+    if (!table_res.has_value()) {
+        sl::error("Unable to build calibration table: {}", table_res.error());
+        return 1;
+    }
+    const auto &table = *table_res;
+    float max_error = 0;
+    for (int i = 0; i <= 1000; i++) {
+        const auto position = i / 1000.f;
+        max_error = glm::max(max_error, glm::abs(table.evaluate(sensor(position)) - (.1f + .8f * position)));
+    }
+    sl::info("Maximum linearization error: {}", max_error);
+    if (max_error > .01f) {
+        sl::error("Calibration table does not linearize the sweep.");
+        return 1;
+    }
+    for (size_t i = 1; i < table.table.size(); i++) {
+        if (table.table[i] < table.table[i - 1]) {
+            sl::error("Calibration table is not monotone at entry #{}.", i);
+            return 1;
+        }
+    }
+    if (table.evaluate(.05f) != .05f || table.evaluate(.95f) != .95f) {
+        sl::error("Calibration table changes input outside the recorded sweep.");
+        return 1;
+    }
+    recorder.reset();
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> noise(-.0005f, .0005f);
+    const auto linear_sensor = [](const float &position) {
+        return .1f + .8f * position;
+    };
+    for (int i = 0; i < 3000; i++) recorder.record(linear_sensor(0) + noise(random));
+    for (int i = 0; i <= 1000; i++) recorder.record(linear_sensor(static_cast<float>(i) / 1000.f) + noise(random));
+    for (int i = 0; i < 3000; i++) recorder.record(linear_sensor(1) + noise(random));
+    for (int i = 1000; i >= 0; i--) recorder.record(linear_sensor(static_cast<float>(i) / 1000.f) + noise(random));
+    for (int i = 0; i < 3000; i++) recorder.record(linear_sensor(0) + noise(random));
+    const auto dwell_res = recorder.build();
+    if (!dwell_res.has_value()) {
+        sl::error("Unable to build calibration table from a sweep with dwells: {}", dwell_res.error());
+        return 1;
+    }
+    float max_dwell_error = 0;
+    for (int i = 0; i <= 1000; i++) {
+        const auto input = linear_sensor(i / 1000.f);
+        max_dwell_error = glm::max(max_dwell_error, glm::abs(dwell_res->evaluate(input) - input));
+    }
+    sl::info("Maximum linearization error with dwells: {}", max_dwell_error);
+    if (max_dwell_error > .01f) {
+        sl::error("Calibration table follows dwell time instead of the sensor response.");
+        return 1;
+    }
+    for (const auto bits : { 10, 12 }) {
+        const auto codes = static_cast<float>(1 << bits);
+        const auto quantize = [&](const float &value) {
+            return glm::floor(value * codes) / codes;
+        };
+        recorder.reset();
+        for (int i = 0; i < 500; i++) recorder.record(quantize(sensor(0) + noise(random)));
+        for (int i = 0; i <= 5000; i++) recorder.record(quantize(sensor(static_cast<float>(i) / 5000.f)));
+        for (int i = 0; i < 500; i++) recorder.record(quantize(sensor(1) + noise(random)));
+        const auto quantized_res = recorder.build();
+        if (!quantized_res.has_value()) {
+            sl::error("Unable to build calibration table from a {}-bit sweep: {}", bits, quantized_res.error());
+            return 1;
+        }
+        float max_quantized_error = 0;
+        for (int i = 0; i <= 1000; i++) {
+            const auto position = i / 1000.f;
+            max_quantized_error = glm::max(max_quantized_error, glm::abs(quantized_res->evaluate(quantize(sensor(position))) - (.1f + .8f * position)));
+        }
+        sl::info("Maximum linearization error with {}-bit input: {}", bits, max_quantized_error);
+        if (max_quantized_error > .01f) {
+            sl::error("Calibration table does not linearize a {}-bit sweep.", bits);
+            return 1;
+        }
+    }
+    sc::pedals::calibration_set set;
+    set.present[2] = 1;
+    set.tables[2] = table;
+    const auto path = std::filesystem::temp_directory_path() / "test_calibration.bin";
+    if (const auto err = sc::pedals::calibration_set::save(path, set); err) {
+        sl::error("Unable to save calibration: {}", *err);
+        return 1;
+    }
+    {
+        const auto load_res = sc::pedals::calibration_set::load(path);
+        if (!load_res.has_value()) {
+            sl::error("Unable to load calibration: {}", load_res.error());
+            return 1;
+        }
+        const auto &loaded = *load_res;
+        if (loaded->present[0] || !loaded->present[2] || loaded->tables[2].evaluate(.3f) != table.evaluate(.3f)) {
+            sl::error("Loaded calibration does not match the saved one.");
+            return 1;
+        }
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include <spdlog/spdlog.h>
+
+#include "filter.h"
+
+#include <glm/common.hpp>
+
+namespace sl = spdlog;
+
+static sc::pedals::filter_chain make_chain(const sc::pedals::filter_stage &stage) {
+    sc::pedals::filter_chain chain;
+    sc::pedals::filter_chain::settings stages;
+    stages[0] = stage;
+    chain.configure(stages);
+    return chain;
+}
+
+int main() {
+    constexpr float interval = .001f;
+    sc::pedals::filter_stage ema;
+    ema.type = sc::pedals::filter_stage::kind::ema;
+    ema.alpha = .5f;
+    auto ema_chain = make_chain(ema);
+    ema_chain.process(0, interval);
+    if (ema_chain.process(1, interval) != .5f || ema_chain.process(1, interval) != .75f) {
+        sl::error("EMA stage does not follow its recurrence.");
+        return 1;
+    }
+    sc::pedals::filter_stage median;
+    median.type = sc::pedals::filter_stage::kind::median;
+    median.window = 5;
+    auto median_chain = make_chain(median);
+    for (int i = 0; i < 10; i++) {
+        if (median_chain.process(i == 6 || i == 7 ? 1.f : .2f, interval) != .2f) {
+            sl::error("Median stage lets a two sample spike through at sample #{}.", i);
+            return 1;
+        }
+    }
+    sc::pedals::filter_stage slew;
+    slew.type = sc::pedals::filter_stage::kind::slew;
+    slew.max_rate = 10;
+    auto slew_chain = make_chain(slew);
+    slew_chain.process(0, interval);
+    for (int i = 1; i <= 100; i++) {
+        const auto value = slew_chain.process(1, interval);
+        if (glm::abs(value - glm::min(1.f, i * slew.max_rate * interval)) > 1e-4f) {
+            sl::error("Slew stage output {} at sample #{} exceeds its rate.", value, i);
+            return 1;
+        }
+    }
+    sc::pedals::filter_stage one_euro;
+    one_euro.type = sc::pedals::filter_stage::kind::one_euro;
+    one_euro.min_cutoff = 1;
+    one_euro.beta = .5f;
+    auto one_euro_chain = make_chain(one_euro);
+    for (int i = 0; i < 100; i++) {
+        if (one_euro_chain.process(.4f, interval) != .4f) {
+            sl::error("One-euro stage drifts on a constant input.");
+            return 1;
+        }
+    }
+    float value = 0;
+    for (int i = 0; i < 5000; i++) value = one_euro_chain.process(.8f, interval);
+    if (glm::abs(value - .8f) > 1e-3f) {
+        sl::error("One-euro stage does not settle after a step: {}", value);
+        return 1;
+    }
+    auto slow = one_euro, fast = one_euro;
+    slow.beta = 0;
+    fast.beta = 5;
+    auto slow_chain = make_chain(slow), fast_chain = make_chain(fast);
+    slow_chain.process(0, interval);
+    fast_chain.process(0, interval);
+    float slow_value = 0, fast_value = 0;
+    for (int i = 1; i <= 50; i++) {
+        slow_value = slow_chain.process(i / 50.f, interval);
+        fast_value = fast_chain.process(i / 50.f, interval);
+    }
+    if (fast_value <= slow_value) {
+        sl::error("One-euro speed coefficient does not reduce lag: {} <= {}", fast_value, slow_value);
+        return 1;
+    }
+    if (sc::pedals::filter_chain::group_delay(median, interval) != 2 * interval || sc::pedals::filter_chain::group_delay(ema, interval) != interval) {
+        sl::error("Group delay estimates do not match their stages.");
+        return 1;
+    }
+    sc::pedals::filter_chain chain;
+    sc::pedals::filter_chain::settings stages;
+    stages[0] = median;
+    stages[1] = one_euro;
+    chain.configure(stages);
+    if (chain.configuration() != stages) {
+        sl::error("Filter chain does not report its configuration.");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include <spdlog/spdlog.h>
+
+#include "spline.h"
+#include "transfer.h"
+
+#include <glm/common.hpp>
+
+namespace sl = spdlog;
+
+int main() {
+    const std::vector<glm::dvec2> points = { { 0, 0 }, { .1, .02 }, { .15, .3 }, { .3, .32 }, { .5, .32 }, { .55, .7 }, { .7, .9 }, { .85, .95 }, { 1, 1 } };
+    const auto spline = sc::pedals::monotone_spline::fit(points);
+    for (const auto &point : points) {
+        if (glm::abs(spline.evaluate(point.x) - point.y) > 1e-12) {
+            sl::error("Spline misses its knot at x = {}.", point.x);
+            return 1;
+        }
+    }
+    double last = spline.evaluate(0);
+    for (int i = 1; i <= 10000; i++) {
+        const auto x = i / 10000.0;
+        const auto y = spline.evaluate(x);
+        if (y < last - 1e-12) {
+            sl::error("Spline is not monotone at x = {}.", x);
+            return 1;
+        }
+        if (x > .3 && x < .5 && glm::abs(y - .32) > 1e-12) {
+            sl::error("Spline overshoots a flat segment at x = {}.", x);
+            return 1;
+        }
+        last = y;
+    }
+    const auto shuffled = sc::pedals::monotone_spline::fit({ { 1, 1 }, { 0, 0 }, { .5, .25 }, { .5, .75 } });
+    if (shuffled.x.size() != 3 || shuffled.evaluate(.5) != .25) {
+        sl::error("Spline does not sort its points or drop duplicate x.");
+        return 1;
+    }
+    sc::pedals::transfer_settings settings;
+    settings.curve_type = sc::pedals::curve_kind::spline;
+    settings.curve = points;
+    const auto lut = sc::pedals::transfer_lut::compile(settings);
+    float max_error = 0;
+    for (int i = 0; i <= 100000; i++) {
+        const auto input = static_cast<float>(i) / 100000.f;
+        max_error = glm::max(max_error, glm::abs(lut.evaluate(input) - static_cast<float>(spline.evaluate(input))));
+    }
+    sl::info("Maximum spline lookup error: {}", max_error);
+    if (max_error > 1.f / 256.f) {
+        sl::error("Spline lookup table deviates from the spline.");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include <spdlog/spdlog.h>
+
+#include "transfer.h"
+#include "batch.h"
+
+#include <glm/common.hpp>
+
+namespace sl = spdlog;
+
+int main() {
+    sc::pedals::transfer_settings settings;
+    settings.range_min = .1f;
+    settings.range_max = .9f;
+    settings.deadzone = .05f;
+    settings.limit = .95f;
+    settings.curve = { { 0, 0 }, { .2, .05 }, { .4, .2 }, { .6, .5 }, { .8, .85 }, { 1, 1 } };
+    const auto lut = sc::pedals::transfer_lut::compile(settings);
+    float max_error = 0;
+    for (int i = 0; i <= 100000; i++) {
+        const auto input = static_cast<float>(i) / 100000.f;
+        max_error = glm::max(max_error, glm::abs(lut.evaluate(input) - sc::pedals::transfer_lut::reference(settings, input)));
+    }
+    sl::info("Maximum lookup error: {}", max_error);
+    if (max_error > 1.f / 256.f) {
+        sl::error("Lookup table deviates from the reference transfer function.");
+        return 1;
+    }
+    if (lut.evaluate(-1.f) != 0.f || lut.evaluate(2.f) != settings.limit) {
+        sl::error("Lookup table does not clamp its input.");
+        return 1;
+    }
+    sc::pedals::axis_batch batch;
+    std::array<sc::pedals::transfer_settings, sc::pedals::axis_batch::lanes> lane_settings;
+    for (size_t lane = 0; lane < lane_settings.size(); lane++) {
+        lane_settings[lane] = settings;
+        lane_settings[lane].deadzone = lane * .05f;
+        if (lane == 2) lane_settings[lane].curve_type = sc::pedals::curve_kind::spline;
+        if (lane == 3) lane_settings[lane].curve.clear();
+        batch.configure(lane, lane_settings[lane]);
+    }
+    for (int i = 0; i <= 10000; i++) {
+        std::array<float, sc::pedals::axis_batch::lanes> inputs, outputs;
+        std::array<uint8_t, sc::pedals::axis_batch::lanes> reports;
+        for (size_t lane = 0; lane < inputs.size(); lane++) inputs[lane] = static_cast<float>((i * (lane + 1)) % 10001) / 10000.f;
+        batch.process(inputs.data(), outputs.data(), reports.data());
+        for (size_t lane = 0; lane < inputs.size(); lane++) {
+            const auto expected = sc::pedals::transfer_lut::reference(lane_settings[lane], inputs[lane]);
+            if (glm::abs(outputs[lane] - expected) > 1.f / 256.f || glm::abs(static_cast<int>(reports[lane]) - static_cast<int>(127 + glm::round(128 * expected))) > 1) {
+                sl::error("Batch lane #{} deviates at input {}: {} ({}), expected {}", lane, inputs[lane], outputs[lane], reports[lane], expected);
+                return 1;
+            }
+        }
+    }
+    auto changed = settings;
+    changed.curve[2].y = .3;
+    if (changed == settings) {
+        sl::error("Settings comparison ignores curve changes.");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
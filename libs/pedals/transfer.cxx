@@ -0,0 +1,54 @@
+#include "transfer.h"
+#include "spline.h"
+
+#include <optional>
+
+#include <glm/common.hpp>
+
+#include "../bezier/bezier.h"
+
+namespace sc::pedals {
+
+    static std::optional<monotone_spline> fit_spline(const transfer_settings &settings) {
+        if (settings.curve_type != curve_kind::spline || settings.curve.size() < 2) return std::nullopt;
+        return monotone_spline::fit(settings.curve);
+    }
+
+    static float shape(const transfer_settings &settings, const std::optional<monotone_spline> &spline, float input) {
+        const auto max_input = settings.range_max;
+        auto min_input = settings.range_min + (settings.range_max - settings.range_min) * settings.deadzone;
+        if (min_input > max_input) min_input = max_input;
+        if (max_input > min_input) input = (input - min_input) / (max_input - min_input);
+        else input = input >= max_input ? 1.f : 0.f;
+        input = glm::clamp(input, 0.f, 1.f);
+        if (spline) input = glm::clamp(static_cast<float>(spline->evaluate(input)), 0.f, 1.f);
+        else if (settings.curve.size() >= 2) input = bezier::calculate(settings.curve, input).y;
+        return glm::min(input, settings.limit);
+    }
+}
+
+bool sc::pedals::transfer_settings::operator==(const transfer_settings &other) const {
+    return range_min == other.range_min && range_max == other.range_max && deadzone == other.deadzone && limit == other.limit && curve_type == other.curve_type && curve == other.curve;
+}
+
+bool sc::pedals::transfer_settings::operator!=(const transfer_settings &other) const {
+    return !(*this == other);
+}
+
+float sc::pedals::transfer_lut::reference(const transfer_settings &settings, float input) {
+    return shape(settings, fit_spline(settings), input);
+}
+
+sc::pedals::transfer_lut sc::pedals::transfer_lut::compile(const transfer_settings &settings) {
+    transfer_lut lut;
+    const auto spline = fit_spline(settings);
+    for (size_t i = 0; i < lut.table.size(); i++) lut.table[i] = shape(settings, spline, static_cast<float>(i) / static_cast<float>(resolution));
+    return lut;
+}
+
+float sc::pedals::transfer_lut::evaluate(const float &input) const {
+    const auto position = glm::clamp(input, 0.f, 1.f) * static_cast<float>(resolution);
+    const auto index = glm::min(static_cast<size_t>(position), resolution - 1);
+    const auto fraction = position - static_cast<float>(index);
+    return table[index] + (table[index + 1] - table[index]) * fraction;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+namespace sc::pedals {
+
+    enum class curve_kind {
+
+        bezier,
+        spline
+    };
+
+    struct transfer_settings {
+
+        float range_min = 0, range_max = 1;
+        float deadzone = 0;
+        float limit = 1;
+        curve_kind curve_type = curve_kind::bezier;
+        std::vector<glm::dvec2> curve;
+
+        bool operator==(const transfer_settings &other) const;
+        bool operator!=(const transfer_settings &other) const;
+    };
+
+    struct transfer_lut {
+
+        static constexpr size_t resolution = 1024;
+
+        std::array<float, resolution + 1> table;
+
+        static transfer_lut compile(const transfer_settings &settings);
+        static float reference(const transfer_settings &settings, float input);
+
+        float evaluate(const float &input) const;
+    };
+}
\ No newline at end of file
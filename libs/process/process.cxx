@@ -0,0 +1,78 @@
+#include "process.h"
+
+#include <algorithm>
+#include <cctype>
+
+#include <spdlog/spdlog.h>
+
+std::string sc::process::normalize_name(const std::string_view &path) {
+    const auto separator = path.find_last_of("/\\");
+    std::string name(separator == std::string_view::npos ? path : path.substr(separator + 1));
+    std::transform(name.begin(), name.end(), name.begin(), [](const unsigned char &c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return name;
+}
+
+sc::process::monitor::monitor(std::unique_ptr<watcher> source, const std::chrono::milliseconds &interval) : source(std::move(source)), interval(interval) {
+
+}
+
+sc::process::monitor::~monitor() {
+    stop();
+}
+
+void sc::process::monitor::start() {
+    stop();
+    working = true;
+    worker = std::thread([this]() {
+        while (working) {
+            poll();
+            for (auto waited = std::chrono::milliseconds(0); working && waited < interval; waited += std::chrono::milliseconds(50)) std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    });
+}
+
+void sc::process::monitor::stop() {
+    working = false;
+    if (worker.joinable()) worker.join();
+}
+
+void sc::process::monitor::poll() {
+    const auto running_res = source->running();
+    if (!running_res.has_value()) {
+        spdlog::warn("Unable to list running processes: {}", running_res.error());
+        return;
+    }
+    std::lock_guard guard(mutex);
+    std::optional<size_t> found;
+    for (size_t i = 0; i < targets.size() && !found; i++) {
+        for (const auto &name : targets[i]) {
+            if (std::find(running_res->begin(), running_res->end(), name) == running_res->end()) continue;
+            found = i;
+            break;
+        }
+    }
+    if (found == matched) return;
+    matched = found;
+    changes++;
+}
+
+void sc::process::monitor::set_targets(const std::vector<std::vector<std::string>> &targets) {
+    std::lock_guard guard(mutex);
+    this->targets = targets;
+    for (auto &names : this->targets) {
+        for (auto &name : names) name = normalize_name(name);
+    }
+    matched.reset();
+    changes++;
+}
+
+std::optional<size_t> sc::process::monitor::active() const {
+    std::lock_guard guard(mutex);
+    return matched;
+}
+
+uint64_t sc::process::monitor::generation() const {
+    return changes;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <tl/expected.hpp>
+
+namespace sc::process {
+
+    struct watcher {
+
+        virtual ~watcher() = default;
+        virtual tl::expected<std::vector<std::string>, std::string> running() = 0;
+    };
+
+    std::string normalize_name(const std::string_view &path);
+    std::unique_ptr<watcher> create_system_watcher();
+
+    struct monitor {
+
+        monitor(std::unique_ptr<watcher> source, const std::chrono::milliseconds &interval = std::chrono::seconds(1));
+        monitor(const monitor &) = delete;
+        monitor &operator=(const monitor &) = delete;
+        ~monitor();
+
+        void start();
+        void stop();
+        void poll();
+
+        void set_targets(const std::vector<std::vector<std::string>> &targets);
+        std::optional<size_t> active() const;
+        uint64_t generation() const;
+
+    private:
+
+        const std::unique_ptr<watcher> source;
+        const std::chrono::milliseconds interval;
+        mutable std::mutex mutex;
+        std::vector<std::vector<std::string>> targets;
+        std::optional<size_t> matched;
+        std::atomic<uint64_t> changes = 0;
+        std::atomic_bool working = false;
+        std::thread worker;
+    };
+}
\ No newline at end of file
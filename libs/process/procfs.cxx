@@ -0,0 +1,31 @@
+#include "process.h"
+
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+
+namespace sc::process {
+
+    struct procfs_watcher : watcher {
+
+        tl::expected<std::vector<std::string>, std::string> running() override {
+            std::error_code ec;
+            std::filesystem::directory_iterator entries("/proc", ec);
+            if (ec) return tl::make_unexpected(ec.message());
+            std::vector<std::string> names;
+            for (const auto &entry : entries) {
+                const auto pid = entry.path().filename().string();
+                if (pid.empty() || !std::isdigit(static_cast<unsigned char>(pid.front()))) continue;
+                std::ifstream cmdline(entry.path() / "cmdline", std::ios::binary);
+                std::string argv0;
+                if (!cmdline || !std::getline(cmdline, argv0, '\0') || argv0.empty()) continue;
+                names.push_back(normalize_name(argv0));
+            }
+            return names;
+        }
+    };
+}
+
+std::unique_ptr<sc::process::watcher> sc::process::create_system_watcher() {
+    return std::make_unique<procfs_watcher>();
+}
\ No newline at end of file
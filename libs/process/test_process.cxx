@@ -0,0 +1,60 @@
+#include <spdlog/spdlog.h>
+
+#include "process.h"
+
+namespace sl = spdlog;
+
+struct fake_watcher : sc::process::watcher {
+
+    std::vector<std::string> &names;
+
+    fake_watcher(std::vector<std::string> &names) : names(names) {
+
+    }
+
+    tl::expected<std::vector<std::string>, std::string> running() override {
+        return names;
+    }
+};
+
+int main() {
+    std::vector<std::string> names = { "explorer.exe", "steam.exe" };
+    sc::process::monitor monitor(std::make_unique<fake_watcher>(names));
+    monitor.set_targets({ { "C:\\Program Files (x86)\\iRacing\\iRacingSim64DX11.exe" }, { "acc.exe", "AC2-Win64-Shipping.exe" } });
+    monitor.poll();
+    if (monitor.active()) {
+        sl::error("Monitor matched a target that is not running.");
+        return 1;
+    }
+    const auto idle_generation = monitor.generation();
+    monitor.poll();
+    if (monitor.generation() != idle_generation) {
+        sl::error("Monitor reports a change without one.");
+        return 1;
+    }
+    names.push_back("ac2-win64-shipping.exe");
+    monitor.poll();
+    if (monitor.active() != 1 || monitor.generation() == idle_generation) {
+        sl::error("Monitor did not match the second target.");
+        return 1;
+    }
+    names.push_back(sc::process::normalize_name("/home/user/.wine/drive_c/iRacing/iRacingSim64DX11.exe"));
+    monitor.poll();
+    if (monitor.active() != 0) {
+        sl::error("Monitor does not prefer the first target.");
+        return 1;
+    }
+    names = { "explorer.exe" };
+    monitor.poll();
+    if (monitor.active()) {
+        sl::error("Monitor keeps a target that exited.");
+        return 1;
+    }
+    auto system = sc::process::create_system_watcher();
+    const auto running = system->running();
+    if (!running.has_value() || running->empty()) {
+        sl::error("Unable to list running processes: {}", running.has_value() ? "none found" : running.error());
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include "process.h"
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <tlhelp32.h>
+
+#include "../defer.hpp"
+
+namespace sc::process {
+
+    struct toolhelp_watcher : watcher {
+
+        tl::expected<std::vector<std::string>, std::string> running() override {
+            const auto snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+            if (snapshot == INVALID_HANDLE_VALUE) return tl::make_unexpected("Unable to take a process snapshot.");
+            DEFER(CloseHandle(snapshot));
+            std::vector<std::string> names;
+            PROCESSENTRY32W entry = { };
+            entry.dwSize = sizeof(entry);
+            for (auto found = Process32FirstW(snapshot, &entry); found; found = Process32NextW(snapshot, &entry)) {
+                char name[MAX_PATH * 3];
+                const auto length = WideCharToMultiByte(CP_UTF8, 0, entry.szExeFile, -1, name, sizeof(name), NULL, NULL);
+                if (length > 1) names.push_back(normalize_name(std::string_view(name, length - 1)));
+            }
+            return names;
+        }
+    };
+}
+
+std::unique_ptr<sc::process::watcher> sc::process::create_system_watcher() {
+    return std::make_unique<toolhelp_watcher>();
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/*
+
+Single-writer, many-reader snapshot of a trivially copyable value.
+
+The writer never blocks and readers never take a lock. A reader that
+overlaps a write simply retries its copy, so the value it returns is
+always one the writer published in full.
+
+~~~
+
+Examples:
+
+    static sc::seqlock<state> published;
+
+    // Worker thread.
+    published.store(current);
+
+    // Any other thread.
+    const auto latest = published.load();
+
+*/
+
+namespace sc {
+
+    template<typename T>
+    class seqlock {
+        static_assert(std::is_trivially_copyable_v<T>, "seqlock requires a trivially copyable type");
+        public:
+            seqlock() = default;
+            explicit seqlock(const T &initial) : value_(initial) {}
+            seqlock(const seqlock &) = delete;
+            seqlock &operator=(const seqlock &) = delete;
+
+            void store(const T &value) {
+                const auto sequence = sequence_.load(std::memory_order_relaxed);
+                sequence_.store(sequence + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                std::memcpy(&value_, &value, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_release);
+                sequence_.store(sequence + 2, std::memory_order_relaxed);
+            }
+
+            T load() const {
+                T copy;
+                for (;;) {
+                    const auto before = sequence_.load(std::memory_order_acquire);
+                    if (before & 1) continue;
+                    std::memcpy(&copy, &value_, sizeof(T));
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (sequence_.load(std::memory_order_relaxed) == before) return copy;
+                }
+            }
+
+            uint64_t sequence() const {
+                return sequence_.load(std::memory_order_acquire) / 2;
+            }
+
+        private:
+            std::atomic<uint64_t> sequence_ = 0;
+            T value_ { };
+    };
+}
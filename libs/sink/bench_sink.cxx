@@ -0,0 +1,53 @@
+#include <spdlog/spdlog.h>
+
+#include "sink.h"
+#include "recorder.h"
+
+#include "../pedals/batch.h"
+#include "../diagnostics/diagnostics.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace sl = spdlog;
+
+static void run(sc::sink::output_sink &output, const sc::pedals::axis_batch &batch, const std::vector<float> &inputs) {
+    constexpr auto lanes = sc::pedals::axis_batch::lanes;
+    sc::diagnostics::histogram process_time, submit_time;
+    sc::sink::gamepad_report report;
+    std::array<float, lanes> outputs;
+    for (size_t frame_i = 0; frame_i < inputs.size() / lanes; frame_i++) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        batch.process(&inputs[frame_i * lanes], outputs.data(), report.axes.data());
+        const auto processed = std::chrono::high_resolution_clock::now();
+        if (const auto err = output.submit(report); err) {
+            sl::error("{}: {}", output.name(), *err);
+            return;
+        }
+        const auto submitted = std::chrono::high_resolution_clock::now();
+        process_time.record(processed - start);
+        submit_time.record(submitted - processed);
+    }
+    sl::info("{}: process mean {}ns p99 <{}ns, submit mean {}ns p99 <{}ns over {} frames", output.name(), process_time.mean().count(), process_time.percentile(.99).count(), submit_time.mean().count(), submit_time.percentile(.99).count(), process_time.count.load());
+}
+
+int main() {
+    constexpr size_t num_frames = 100000;
+    sc::pedals::axis_batch batch;
+    std::vector<float> inputs(num_frames * sc::pedals::axis_batch::lanes);
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> distribution(0.f, 1.f);
+    for (auto &input : inputs) input = distribution(generator);
+    sc::sink::recorder recorder(num_frames);
+    run(recorder, batch, inputs);
+#ifdef __linux__
+    if (auto res = sc::sink::create_uinput("Sim Coaches Virtual Pedals"); res.has_value()) run(**res, batch, inputs);
+    else sl::warn(res.error());
+#endif
+#ifdef _WIN32
+    if (auto res = sc::sink::create_vigem_ds4(0x0070, 0x1209); res.has_value()) run(**res, batch, inputs);
+    else sl::warn(res.error());
+#endif
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "gate.h"
+
+sc::sink::change_gate::change_gate(std::unique_ptr<output_sink> target, const std::chrono::milliseconds &keep_alive) : inner(std::move(target)), keep_alive_ms(keep_alive.count()) {
+
+}
+
+std::string_view sc::sink::change_gate::name() const {
+    return inner->name();
+}
+
+std::optional<std::string> sc::sink::change_gate::submit(const gamepad_report &report) {
+    return submit(report, clock::now());
+}
+
+std::optional<std::string> sc::sink::change_gate::submit(const gamepad_report &report, const clock::time_point &now) {
+    update_rate(now);
+    if (last_report && *last_report == report && now - last_submission < std::chrono::milliseconds(keep_alive_ms.load())) {
+        suppressed++;
+        return std::nullopt;
+    }
+    if (const auto err = inner->submit(report); err) return err;
+    last_report = report;
+    last_submission = now;
+    window_submissions++;
+    submitted++;
+    return std::nullopt;
+}
+
+void sc::sink::change_gate::update_rate(const clock::time_point &now) {
+    if (window_start == clock::time_point()) window_start = now;
+    const auto elapsed = now - window_start;
+    if (elapsed < std::chrono::seconds(1)) return;
+    rate = window_submissions / std::chrono::duration<float>(elapsed).count();
+    window_start = now;
+    window_submissions = 0;
+}
+
+void sc::sink::change_gate::set_keep_alive(const std::chrono::milliseconds &interval) {
+    keep_alive_ms = interval.count();
+}
+
+std::chrono::milliseconds sc::sink::change_gate::keep_alive() const {
+    return std::chrono::milliseconds(keep_alive_ms.load());
+}
+
+uint64_t sc::sink::change_gate::num_submitted() const {
+    return submitted;
+}
+
+uint64_t sc::sink::change_gate::num_suppressed() const {
+    return suppressed;
+}
+
+float sc::sink::change_gate::submissions_per_second() const {
+    return rate;
+}
+
+sc::sink::output_sink &sc::sink::change_gate::target() {
+    return *inner;
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "sink.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace sc::sink {
+
+    struct change_gate : output_sink {
+
+        using clock = std::chrono::high_resolution_clock;
+
+        change_gate(std::unique_ptr<output_sink> target, const std::chrono::milliseconds &keep_alive = std::chrono::milliseconds(250));
+
+        std::string_view name() const override;
+        std::optional<std::string> submit(const gamepad_report &report) override;
+        std::optional<std::string> submit(const gamepad_report &report, const clock::time_point &now);
+
+        void set_keep_alive(const std::chrono::milliseconds &interval);
+        std::chrono::milliseconds keep_alive() const;
+
+        uint64_t num_submitted() const;
+        uint64_t num_suppressed() const;
+        float submissions_per_second() const;
+
+        output_sink &target();
+
+    private:
+
+        const std::unique_ptr<output_sink> inner;
+        std::atomic<int64_t> keep_alive_ms;
+        std::optional<gamepad_report> last_report;
+        clock::time_point last_submission;
+        clock::time_point window_start;
+        uint64_t window_submissions = 0;
+        std::atomic<uint64_t> submitted = 0, suppressed = 0;
+        std::atomic<float> rate = 0;
+
+        void update_rate(const clock::time_point &now);
+    };
+}
\ No newline at end of file
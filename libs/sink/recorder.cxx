@@ -0,0 +1,56 @@
+#include "recorder.h"
+
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include "../file/file.h"
+
+sc::sink::recorder::recorder(const size_t &capacity) : capacity(capacity) {
+    history.reserve(capacity);
+}
+
+std::string_view sc::sink::recorder::name() const {
+    return "Recorder";
+}
+
+std::optional<std::string> sc::sink::recorder::submit(const gamepad_report &report) {
+    const auto now = std::chrono::high_resolution_clock::now();
+    std::lock_guard guard(mutex);
+    if (history.size() < capacity) history.push_back({ now, report });
+    else history[num_total % capacity] = { now, report };
+    num_total++;
+    return std::nullopt;
+}
+
+std::vector<sc::sink::recorder::entry> sc::sink::recorder::entries() const {
+    std::lock_guard guard(mutex);
+    if (history.size() < capacity) return history;
+    std::vector<entry> ordered;
+    ordered.reserve(history.size());
+    for (size_t i = 0; i < history.size(); i++) ordered.push_back(history[(num_total + i) % capacity]);
+    return ordered;
+}
+
+size_t sc::sink::recorder::num_submitted() const {
+    std::lock_guard guard(mutex);
+    return num_total;
+}
+
+void sc::sink::recorder::clear() {
+    std::lock_guard guard(mutex);
+    history.clear();
+    num_total = 0;
+}
+
+std::optional<std::string> sc::sink::recorder::save(const std::filesystem::path &path) const {
+    const auto list = entries();
+    std::string doc_content = "time_ns,left_x,left_y,right_x,right_y,trigger_left,trigger_right,buttons\n";
+    for (const auto &item : list) {
+        const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(item.time - list.front().time).count();
+        doc_content += fmt::format("{},{},{},{},{},{},{},{}\n", time, item.report.axes[0], item.report.axes[1], item.report.axes[2], item.report.axes[3], item.report.trigger_left, item.report.trigger_right, item.report.buttons);
+    }
+    std::vector<std::byte> doc_data(doc_content.size());
+    memcpy(doc_data.data(), doc_content.data(), doc_content.size());
+    return file::save(path, doc_data);
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "sink.h"
+
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+namespace sc::sink {
+
+    struct recorder : output_sink {
+
+        struct entry {
+
+            std::chrono::high_resolution_clock::time_point time;
+            gamepad_report report;
+        };
+
+        recorder(const size_t &capacity = 1 << 16);
+
+        std::string_view name() const override;
+        std::optional<std::string> submit(const gamepad_report &report) override;
+
+        std::vector<entry> entries() const;
+        size_t num_submitted() const;
+        void clear();
+        std::optional<std::string> save(const std::filesystem::path &path) const;
+
+    private:
+
+        mutable std::mutex mutex;
+        const size_t capacity;
+        std::vector<entry> history;
+        size_t num_total = 0;
+    };
+}
\ No newline at end of file
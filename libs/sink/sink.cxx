@@ -0,0 +1,9 @@
+#include "sink.h"
+
+bool sc::sink::gamepad_report::operator==(const gamepad_report &other) const {
+    return axes == other.axes && trigger_left == other.trigger_left && trigger_right == other.trigger_right && buttons == other.buttons;
+}
+
+bool sc::sink::gamepad_report::operator!=(const gamepad_report &other) const {
+    return !(*this == other);
+}
\ No newline at end of file
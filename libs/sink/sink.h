@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <tl/expected.hpp>
+
+namespace sc::sink {
+
+    struct gamepad_report {
+
+        enum axis_index {
+
+            left_x,
+            left_y,
+            right_x,
+            right_y
+        };
+
+        enum button : uint16_t {
+
+            button_south = 1 << 0,
+            button_east = 1 << 1,
+            button_west = 1 << 2,
+            button_north = 1 << 3,
+            button_shoulder_left = 1 << 4,
+            button_shoulder_right = 1 << 5,
+            button_trigger_left = 1 << 6,
+            button_trigger_right = 1 << 7,
+            button_back = 1 << 8,
+            button_start = 1 << 9,
+            button_thumb_left = 1 << 10,
+            button_thumb_right = 1 << 11
+        };
+
+        std::array<uint8_t, 4> axes = { 128, 128, 128, 128 };
+        uint8_t trigger_left = 0, trigger_right = 0;
+        uint16_t buttons = 0;
+
+        bool operator==(const gamepad_report &other) const;
+        bool operator!=(const gamepad_report &other) const;
+    };
+
+    struct output_sink {
+
+        virtual ~output_sink() = default;
+        virtual std::string_view name() const = 0;
+        virtual std::optional<std::string> submit(const gamepad_report &report) = 0;
+    };
+
+#ifdef _WIN32
+    tl::expected<std::unique_ptr<output_sink>, std::string> create_vigem_ds4(const uint16_t &vendor, const uint16_t &product);
+    tl::expected<std::unique_ptr<output_sink>, std::string> create_vigem_x360();
+#endif
+
+#ifdef __linux__
+    tl::expected<std::unique_ptr<output_sink>, std::string> create_uinput(const std::string_view &device_name);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include <spdlog/spdlog.h>
+
+#include "gate.h"
+#include "recorder.h"
+
+namespace sl = spdlog;
+
+int main() {
+    sc::sink::change_gate gate(std::make_unique<sc::sink::recorder>(), std::chrono::milliseconds(100));
+    auto &recorder = static_cast<sc::sink::recorder &>(gate.target());
+    const auto start = sc::sink::change_gate::clock::now();
+    sc::sink::gamepad_report report;
+    for (int tick = 0; tick < 1000; tick++) {
+        if (tick == 500) report.axes[sc::sink::gamepad_report::left_x] = 200;
+        if (const auto err = gate.submit(report, start + std::chrono::milliseconds(tick)); err) {
+            sl::error(*err);
+            return 1;
+        }
+    }
+    sl::info("Submitted: {}, suppressed: {}", gate.num_submitted(), gate.num_suppressed());
+    if (recorder.num_submitted() != gate.num_submitted() || gate.num_submitted() + gate.num_suppressed() != 1000) {
+        sl::error("Gate counters do not match the recorded reports.");
+        return 1;
+    }
+    if (gate.num_submitted() != 10) {
+        sl::error("Expected 10 submissions (first report, change and keep-alives), got {}.", gate.num_submitted());
+        return 1;
+    }
+    const auto entries = recorder.entries();
+    if (entries[5].report.axes[sc::sink::gamepad_report::left_x] != 200) {
+        sl::error("Changed report was not submitted immediately.");
+        return 1;
+    }
+    gate.submit(report, start + std::chrono::milliseconds(1000));
+    if (gate.submissions_per_second() < 10.f || gate.submissions_per_second() > 12.f) {
+        sl::error("Unexpected submission rate: {}", gate.submissions_per_second());
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
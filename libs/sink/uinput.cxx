@@ -0,0 +1,106 @@
+#include "sink.h"
+
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/uinput.h>
+
+#include <fmt/format.h>
+
+namespace sc::sink {
+
+    static constexpr std::array<int, 4> uinput_axes = { ABS_X, ABS_Y, ABS_RX, ABS_RY };
+    static constexpr std::array<std::pair<uint16_t, int>, 12> uinput_buttons = { {
+        { gamepad_report::button_south, BTN_SOUTH },
+        { gamepad_report::button_east, BTN_EAST },
+        { gamepad_report::button_west, BTN_WEST },
+        { gamepad_report::button_north, BTN_NORTH },
+        { gamepad_report::button_shoulder_left, BTN_TL },
+        { gamepad_report::button_shoulder_right, BTN_TR },
+        { gamepad_report::button_trigger_left, BTN_TL2 },
+        { gamepad_report::button_trigger_right, BTN_TR2 },
+        { gamepad_report::button_back, BTN_SELECT },
+        { gamepad_report::button_start, BTN_START },
+        { gamepad_report::button_thumb_left, BTN_THUMBL },
+        { gamepad_report::button_thumb_right, BTN_THUMBR }
+    } };
+
+    struct uinput_sink : output_sink {
+
+        const int fd;
+
+        uinput_sink(const int &fd) : fd(fd) {
+
+        }
+
+        ~uinput_sink() {
+            ioctl(fd, UI_DEV_DESTROY);
+            close(fd);
+        }
+
+        std::string_view name() const override {
+            return "uinput";
+        }
+
+        std::optional<std::string> submit(const gamepad_report &report) override {
+            std::array<input_event, uinput_axes.size() + 2 + uinput_buttons.size() + 1> events;
+            memset(events.data(), 0, sizeof(events));
+            size_t num_events = 0;
+            const auto emit = [&](const uint16_t &type, const uint16_t &code, const int32_t &value) {
+                events[num_events].type = type;
+                events[num_events].code = code;
+                events[num_events].value = value;
+                num_events++;
+            };
+            for (size_t i = 0; i < uinput_axes.size(); i++) emit(EV_ABS, uinput_axes[i], report.axes[i]);
+            emit(EV_ABS, ABS_Z, report.trigger_left);
+            emit(EV_ABS, ABS_RZ, report.trigger_right);
+            for (const auto &[bit, code] : uinput_buttons) emit(EV_KEY, code, (report.buttons & bit) ? 1 : 0);
+            emit(EV_SYN, SYN_REPORT, 0);
+            const auto num_bytes = sizeof(input_event) * num_events;
+            if (write(fd, events.data(), num_bytes) != static_cast<ssize_t>(num_bytes)) return fmt::format("Unable to write to uinput device: {}", strerror(errno));
+            return std::nullopt;
+        }
+    };
+}
+
+tl::expected<std::unique_ptr<sc::sink::output_sink>, std::string> sc::sink::create_uinput(const std::string_view &device_name) {
+    const auto fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK);
+    if (fd < 0) return tl::make_unexpected(fmt::format("Unable to open /dev/uinput: {}", strerror(errno)));
+    const auto fail = [fd](const std::string_view &message) {
+        const auto reason = fmt::format("{}: {}", message, strerror(errno));
+        close(fd);
+        return tl::make_unexpected(reason);
+    };
+    if (ioctl(fd, UI_SET_EVBIT, EV_KEY) < 0 || ioctl(fd, UI_SET_EVBIT, EV_ABS) < 0) return fail("Unable to enable uinput event types");
+    for (const auto &[bit, code] : uinput_buttons) {
+        if (ioctl(fd, UI_SET_KEYBIT, code) < 0) return fail("Unable to enable uinput button");
+    }
+    std::array<int, uinput_axes.size() + 2> all_axes;
+    std::copy(uinput_axes.begin(), uinput_axes.end(), all_axes.begin());
+    all_axes[uinput_axes.size()] = ABS_Z;
+    all_axes[uinput_axes.size() + 1] = ABS_RZ;
+    for (const auto &axis : all_axes) {
+        if (ioctl(fd, UI_SET_ABSBIT, axis) < 0) return fail("Unable to enable uinput axis");
+        uinput_abs_setup setup;
+        memset(&setup, 0, sizeof(setup));
+        setup.code = axis;
+        setup.absinfo.minimum = 0;
+        setup.absinfo.maximum = 255;
+        if (ioctl(fd, UI_ABS_SETUP, &setup) < 0) return fail("Unable to configure uinput axis");
+    }
+    uinput_setup setup;
+    memset(&setup, 0, sizeof(setup));
+    setup.id.bustype = BUS_VIRTUAL;
+    setup.id.vendor = 0x0070;
+    setup.id.product = 0x1209;
+    strncpy(setup.name, device_name.data(), std::min(device_name.size(), sizeof(setup.name) - 1));
+    if (ioctl(fd, UI_DEV_SETUP, &setup) < 0) return fail("Unable to configure uinput device");
+    if (ioctl(fd, UI_DEV_CREATE) < 0) return fail("Unable to create uinput device");
+    return std::make_unique<uinput_sink>(fd);
+}
\ No newline at end of file
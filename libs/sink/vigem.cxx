@@ -0,0 +1,138 @@
+#include "sink.h"
+
+#define WIN32_LEAN_AND_MEAN
+
+#include <windows.h>
+
+#include "../vigem/client.h"
+
+#include <array>
+#include <utility>
+
+namespace sc::sink {
+
+    static constexpr std::array<std::pair<uint16_t, USHORT>, 12> ds4_buttons = { {
+        { gamepad_report::button_south, DS4_BUTTON_CROSS },
+        { gamepad_report::button_east, DS4_BUTTON_CIRCLE },
+        { gamepad_report::button_west, DS4_BUTTON_SQUARE },
+        { gamepad_report::button_north, DS4_BUTTON_TRIANGLE },
+        { gamepad_report::button_shoulder_left, DS4_BUTTON_SHOULDER_LEFT },
+        { gamepad_report::button_shoulder_right, DS4_BUTTON_SHOULDER_RIGHT },
+        { gamepad_report::button_trigger_left, DS4_BUTTON_TRIGGER_LEFT },
+        { gamepad_report::button_trigger_right, DS4_BUTTON_TRIGGER_RIGHT },
+        { gamepad_report::button_back, DS4_BUTTON_SHARE },
+        { gamepad_report::button_start, DS4_BUTTON_OPTIONS },
+        { gamepad_report::button_thumb_left, DS4_BUTTON_THUMB_LEFT },
+        { gamepad_report::button_thumb_right, DS4_BUTTON_THUMB_RIGHT }
+    } };
+
+    static constexpr std::array<std::pair<uint16_t, USHORT>, 10> x360_buttons = { {
+        { gamepad_report::button_south, XUSB_GAMEPAD_A },
+        { gamepad_report::button_east, XUSB_GAMEPAD_B },
+        { gamepad_report::button_west, XUSB_GAMEPAD_X },
+        { gamepad_report::button_north, XUSB_GAMEPAD_Y },
+        { gamepad_report::button_shoulder_left, XUSB_GAMEPAD_LEFT_SHOULDER },
+        { gamepad_report::button_shoulder_right, XUSB_GAMEPAD_RIGHT_SHOULDER },
+        { gamepad_report::button_back, XUSB_GAMEPAD_BACK },
+        { gamepad_report::button_start, XUSB_GAMEPAD_START },
+        { gamepad_report::button_thumb_left, XUSB_GAMEPAD_LEFT_THUMB },
+        { gamepad_report::button_thumb_right, XUSB_GAMEPAD_RIGHT_THUMB }
+    } };
+
+    template<size_t N>
+    static USHORT map_buttons(const uint16_t &buttons, const std::array<std::pair<uint16_t, USHORT>, N> &layout) {
+        USHORT result = 0;
+        for (const auto &[bit, mapped] : layout) {
+            if (buttons & bit) result |= mapped;
+        }
+        return result;
+    }
+
+    static SHORT to_thumb(const uint8_t &value, const bool &inverted = false) {
+        const auto centered = static_cast<int>(value) * 257 - 32768;
+        return static_cast<SHORT>(inverted ? -1 - centered : centered);
+    }
+
+    struct vigem_sink : output_sink {
+
+        const VIGEM_TARGET_TYPE type;
+        PVIGEM_CLIENT client;
+        PVIGEM_TARGET target;
+
+        vigem_sink(const VIGEM_TARGET_TYPE &type, PVIGEM_CLIENT client, PVIGEM_TARGET target) : type(type), client(client), target(target) {
+
+        }
+
+        ~vigem_sink() {
+            vigem_target_remove(client, target);
+            vigem_target_free(target);
+            vigem_disconnect(client);
+            vigem_free(client);
+        }
+
+        std::string_view name() const override {
+            return type == DualShock4Wired ? "ViGEm DS4" : "ViGEm X360";
+        }
+
+        std::optional<std::string> submit(const gamepad_report &report) override {
+            if (type == DualShock4Wired) {
+                DS4_REPORT ds4;
+                DS4_REPORT_INIT(&ds4);
+                ds4.bThumbLX = report.axes[gamepad_report::left_x];
+                ds4.bThumbLY = report.axes[gamepad_report::left_y];
+                ds4.bThumbRX = report.axes[gamepad_report::right_x];
+                ds4.bThumbRY = report.axes[gamepad_report::right_y];
+                ds4.bTriggerL = report.trigger_left;
+                ds4.bTriggerR = report.trigger_right;
+                ds4.wButtons |= map_buttons(report.buttons, ds4_buttons);
+                if (!VIGEM_SUCCESS(vigem_target_ds4_update(client, target, ds4))) return "Unable to submit gamepad report to ViGEmBus.";
+            } else {
+                XUSB_REPORT x360;
+                XUSB_REPORT_INIT(&x360);
+                x360.sThumbLX = to_thumb(report.axes[gamepad_report::left_x]);
+                x360.sThumbLY = to_thumb(report.axes[gamepad_report::left_y], true);
+                x360.sThumbRX = to_thumb(report.axes[gamepad_report::right_x]);
+                x360.sThumbRY = to_thumb(report.axes[gamepad_report::right_y], true);
+                x360.bLeftTrigger = (report.buttons & gamepad_report::button_trigger_left) ? 255 : report.trigger_left;
+                x360.bRightTrigger = (report.buttons & gamepad_report::button_trigger_right) ? 255 : report.trigger_right;
+                x360.wButtons = map_buttons(report.buttons, x360_buttons);
+                if (!VIGEM_SUCCESS(vigem_target_x360_update(client, target, x360))) return "Unable to submit gamepad report to ViGEmBus.";
+            }
+            return std::nullopt;
+        }
+    };
+
+    static tl::expected<std::unique_ptr<output_sink>, std::string> create_vigem(const VIGEM_TARGET_TYPE &type, const std::optional<std::pair<uint16_t, uint16_t>> &ids) {
+        auto client = vigem_alloc();
+        if (!client) return tl::make_unexpected("Unable to allocate required memory for ViGEmBus driver connection.");
+        if (!VIGEM_SUCCESS(vigem_connect(client))) {
+            vigem_free(client);
+            return tl::make_unexpected("Unable to connect to ViGEmBus driver.");
+        }
+        auto target = type == DualShock4Wired ? vigem_target_ds4_alloc() : vigem_target_x360_alloc();
+        if (!target) {
+            vigem_disconnect(client);
+            vigem_free(client);
+            return tl::make_unexpected("Unable to allocate required memory for ViGEmBus gamepad target.");
+        }
+        if (ids) {
+            vigem_target_set_vid(target, ids->first);
+            vigem_target_set_pid(target, ids->second);
+        }
+        if (!VIGEM_SUCCESS(vigem_target_add(client, target))) {
+            vigem_target_free(target);
+            vigem_disconnect(client);
+            vigem_free(client);
+            return tl::make_unexpected("Unable to activate ViGEmBus gamepad.");
+        }
+        return std::make_unique<vigem_sink>(type, client, target);
+    }
+}
+
+tl::expected<std::unique_ptr<sc::sink::output_sink>, std::string> sc::sink::create_vigem_ds4(const uint16_t &vendor, const uint16_t &product) {
+    return create_vigem(DualShock4Wired, std::make_pair(vendor, product));
+}
+
+tl::expected<std::unique_ptr<sc::sink::output_sink>, std::string> sc::sink::create_vigem_x360() {
+    return create_vigem(Xbox360Wired, std::nullopt);
+}
\ No newline at end of file
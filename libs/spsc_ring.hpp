@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+/*
+
+Bounded, lock-free ring for one producer and one consumer, where every
+slot holds a fixed-width run of trivially copyable values and a stamp.
+
+The width is chosen at runtime, so one ring type carries scalars and
+arrays alike. The producer writes straight into the next free slot and
+commits it; a full ring refuses the write instead of blocking, so a slow
+consumer can never stall the producer.
+
+~~~
+
+Examples:
+
+    sc::spsc_ring<float> ring(64, 256);
+
+    // Producer thread.
+    if (auto slot = ring.try_acquire()) {
+        std::copy_n(values, 64, slot);
+        ring.commit(tick);
+    }
+
+    // Consumer thread.
+    int64_t tick;
+    std::array<float, 64> values;
+    while (ring.try_pop(tick, values.data())) use(tick, values);
+
+*/
+
+namespace sc {
+
+    template<typename T>
+    class spsc_ring {
+        static_assert(std::is_trivially_copyable_v<T>, "spsc_ring requires a trivially copyable type");
+        public:
+            spsc_ring(const size_t &width, const size_t &capacity) : width_(width), capacity_(round_up(capacity)), values_(new T[width_ * capacity_] { }), stamps_(new int64_t[capacity_] { }) {}
+            spsc_ring(const spsc_ring &) = delete;
+            spsc_ring &operator=(const spsc_ring &) = delete;
+
+            size_t width() const {
+                return width_;
+            }
+
+            size_t capacity() const {
+                return capacity_;
+            }
+
+            T *try_acquire() {
+                const auto tail = tail_.load(std::memory_order_relaxed);
+                if (tail - head_.load(std::memory_order_acquire) >= capacity_) return nullptr;
+                return &values_[(tail & (capacity_ - 1)) * width_];
+            }
+
+            void commit(const int64_t &stamp) {
+                const auto tail = tail_.load(std::memory_order_relaxed);
+                stamps_[tail & (capacity_ - 1)] = stamp;
+                tail_.store(tail + 1, std::memory_order_release);
+            }
+
+            bool try_pop(int64_t &stamp, T *values) {
+                const auto head = head_.load(std::memory_order_relaxed);
+                if (head == tail_.load(std::memory_order_acquire)) return false;
+                stamp = stamps_[head & (capacity_ - 1)];
+                std::memcpy(values, &values_[(head & (capacity_ - 1)) * width_], width_ * sizeof(T));
+                head_.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            size_t size() const {
+                return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+            }
+
+        private:
+            static size_t round_up(const size_t &capacity) {
+                size_t result = 2;
+                while (result < capacity) result <<= 1;
+                return result;
+            }
+
+            const size_t width_, capacity_;
+            const std::unique_ptr<T[]> values_;
+            const std::unique_ptr<int64_t[]> stamps_;
+            alignas(64) std::atomic<size_t> tail_ = 0;
+            alignas(64) std::atomic<size_t> head_ = 0;
+    };
+}
\ No newline at end of file